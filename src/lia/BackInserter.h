@@ -0,0 +1,232 @@
+/*
++-----------------------------------+
+|                                   |
+|                 A                 |
+|                A A                |
+|               A   A               |
+|              A     A              |
+|  #  AAAAAAAAAAAAAAAAAAAAAAAAA  #  |
+|  ###       A         A       ###  |
+|  ######   A           A    #####  |
+|  ####### A             A #######  |
+|                                   |
++-----------------------------------+
+
+L I B A C R O S S - Using C++ containers
+ across DLL- and ABI-stable boundaries
+
+If you like this project, please refer to it with a link or
+some other reference. You can use this ASCII art icon as well
+as the supplied graphical icons for that purpose.
+
+(c) Copyright 2019 Jens Ganter-Benzing
+
+Licensed under the MIT license:
+
+http://www.opensource.org/licenses/mit-license.php
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#ifndef lia_BackInserter_h_INCLUDED
+#define lia_BackInserter_h_INCLUDED
+
+#include <lia/IVector.h>
+#include <lia/detail/PushWarnings.h>
+
+#ifdef __cplusplus
+
+#include <new>
+
+namespace lia {
+
+//! Appends elements to an IVector<T>, but stages them in a local buffer first. The buffer is appended
+//! to the vector with one call over the ABI boundary when it is full, when flush() is called and
+//! at the latest on destruction. That way, appending many single elements doesn't cost a virtual call
+//! per element. Elements that are pushed into a BackInserter are not visible in the vector until
+//! they are flushed.
+//!
+//! IMPORTANT: The destructor can't report errors. If the final flush() on destruction fails, the elements that
+//! are still staged are destroyed without being appended, and the error is silently dropped. Call flush()
+//! before the BackInserter goes out of scope wherever a failed append must be noticed.
+//!
+//! Elements that are expensive to copy are moved into the vector one by one if the implementation supports
+//! that (IVector version 0.14), because a virtual call per element is cheaper than a deep copy.
+//! Only element types that aren't lia interfaces can be staged.
+template<typename T, std::size_t N = 256u>
+class BackInserter {
+public:
+
+	lia_STATIC_ASSERT((!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value), "BackInserter can't stage lia interfaces")
+	lia_STATIC_ASSERT((N > 0u), "BackInserter needs a buffer of at least one element")
+
+	typedef BackInserter<T, N> ThisType;
+
+	explicit BackInserter(IVector<T>& v) lia_NOEXCEPT: m_vector(v), m_hasInsertRange(false), m_hasInsertMove(false), m_size(0) {
+		InterfaceVersion version;
+		m_vector.abiGetIVectorVersion(version);
+		m_hasInsertRange = (version.major == 0) && (version.minor >= 2);
+		m_hasInsertMove  = (version.major == 0) && (version.minor >= 14);
+	}
+
+	//! Flushes the staged elements, but swallows any error, see the class documentation
+	~BackInserter() {
+		lia_TRY
+			flush();
+		lia_CATCHALL((void)0)
+		destroy(0, m_size);
+	}
+
+	void push_back(const T& value) {
+		if (m_size == N) {
+			flush();
+		}
+		new(elemAt(m_size)) T(value);
+		++m_size;
+	}
+
+#if lia_CPP11_API
+
+	void push_back(T&& value) {
+		if (m_size == N) {
+			flush();
+		}
+		new(elemAt(m_size)) T(std::move(value));
+		++m_size;
+	}
+
+	//! Constructs the element in the buffer
+	template<typename... Args>
+	void emplace_back(Args&&... args) {
+		if (m_size == N) {
+			flush();
+		}
+		new(elemAt(m_size)) T(std::forward<Args>(args)...);
+		++m_size;
+	}
+
+#endif
+
+	//! Appends all staged elements to the vector. If that fails, the elements that couldn't be appended stay staged.
+	void flush() {
+		if (m_size == 0) {
+			return;
+		}
+#if lia_CPP11_API
+		if (m_hasInsertMove && !lia::detail::IsTriviallyRelocatable<T>::value) {
+			flushMove();
+			return;
+		}
+#endif
+		flushCopy();
+	}
+
+	//! Returns the number of elements that are staged and not yet appended to the vector
+	std::size_t staged() const lia_NOEXCEPT {
+		return m_size;
+	}
+
+private:
+
+	BackInserter(const BackInserter&);
+	BackInserter& operator=(const BackInserter&);
+
+	T* elemAt(std::size_t i) lia_NOEXCEPT {
+		return reinterpret_cast<T*>(m_buf.data) + i;
+	}
+
+	void destroy(std::size_t first, std::size_t last) lia_NOEXCEPT {
+		for (std::size_t i=first; i<last; ++i) {
+			elemAt(i)->~T();
+		}
+	}
+
+	// Removes the first n staged elements, which were appended already and must not be appended twice
+	void discardFront(std::size_t n) {
+		for (std::size_t i=n; i<m_size; ++i) {
+#if lia_CPP11_API
+			*elemAt(i - n) = std::move(*elemAt(i));
+#else
+			*elemAt(i - n) = *elemAt(i);
+#endif
+		}
+		destroy(m_size - n, m_size);
+		m_size -= n;
+	}
+
+	void flushCopy() {
+		typename lia::detail::MakeTypes<T>::ConstPointer elems[N];
+		for (std::size_t i=0; i<m_size; ++i) {
+			lia::detail::assignElemPtr(elems[i], *elemAt(i));
+		}
+		const abi_size_t pos = m_vector.abiGetSize();
+		const abi_size_t n   = static_cast<abi_size_t>(m_size);
+		if (m_hasInsertRange) {
+			if (!m_vector.abiInsertRange(pos, elems, n)) {
+				lia_THROW0(std::bad_alloc);
+			}
+		}
+		else {
+			for (abi_size_t i=0; i<n; ++i) {
+				if (!m_vector.abiInsert(pos + i, elems[i])) {
+					discardFront(static_cast<std::size_t>(i));
+					lia_THROW0(std::bad_alloc);
+				}
+			}
+		}
+		destroy(0, m_size);
+		m_size = 0;
+	}
+
+	void flushMove() {
+		const abi_size_t pos = m_vector.abiGetSize();
+		for (std::size_t i=0; i<m_size; ++i) {
+			typename lia::detail::MakeTypes<T>::Pointer pElem;
+			lia::detail::assignElemPtr(pElem, *elemAt(i));
+			if (!m_vector.abiInsertMove(pos + static_cast<abi_size_t>(i), pElem)) {
+				discardFront(i);
+				lia_THROW0(std::bad_alloc);
+			}
+		}
+		destroy(0, m_size);
+		m_size = 0;
+	}
+
+	IVector<T>& m_vector;
+	bool        m_hasInsertRange;
+	bool        m_hasInsertMove;
+	std::size_t m_size;
+
+	// Raw storage, the staged elements [0, m_size) are constructed in it with placement new
+	union Data {
+		memalign_t alignmentDummy;
+#if lia_CPP11_API
+		alignas(T) char data[N * sizeof(T)];
+#else
+		char data[N * sizeof(T)];
+#endif
+	} m_buf;
+};
+
+}
+
+#endif
+
+#include <lia/detail/PopWarnings.h>
+
+#endif
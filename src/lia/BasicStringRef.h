@@ -67,13 +67,25 @@ public:
 
 	virtual void lia_CALL abiGetIBasicStringVersion(InterfaceVersion& v) const lia_NOEXCEPT lia_OVERRIDE {
 		v.major = 0;
-		v.minor = 1;
+		v.minor = 3;
 	}
 
 	virtual void lia_CALL abiDestroy() lia_NOEXCEPT lia_OVERRIDE {
 		delete this;
 	}
 
+	virtual uint32_t lia_CALL abiGetCapabilities(const char* pCallerToolchainId) const lia_NOEXCEPT lia_OVERRIDE {
+		return kCapContiguousStorage | kCapTriviallyRelocatable | kCapThreadSafeReads | lia::detail::getToolchainCapability(pCallerToolchainId);
+	}
+
+	virtual void* lia_CALL abiGetNativeObject(const char* pCallerToolchainId, const char* pNativeTypeId) const lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::RemoveReference<TString>::type TStorage;
+		if (!lia::detail::isNativeTypeOfCaller<TStorage>(pCallerToolchainId, pNativeTypeId)) {
+			return lia_NULLPTR;
+		}
+		return const_cast<TStorage*>(&m_string);
+	}
+
 private:
 	TString m_string; // either a reference or a type
 };
@@ -65,6 +65,8 @@ class IBasicString;
 //! semver | notes
 //! ------ | --------
 //! 0.1    | Pre-release version
+//! 0.2    | Added abiGetCapabilities()
+//! 0.3    | Added abiGetNativeObject()
 //!
 template<typename T>
 class IBasicString: public lia_IBasicString_BASE(T) {
@@ -98,8 +100,10 @@ public:
 	}
 #endif
 
-	/* vtable index  0 */ virtual void lia_CALL abiGetIBasicStringVersion(InterfaceVersion& v) const lia_NOEXCEPT = 0;
-	/* vtable index  1 */ virtual void lia_CALL abiDestroy() lia_NOEXCEPT = 0;
+	/* vtable index  0 */ virtual void     lia_CALL abiGetIBasicStringVersion(InterfaceVersion& v) const lia_NOEXCEPT = 0;
+	/* vtable index  1 */ virtual void     lia_CALL abiDestroy() lia_NOEXCEPT = 0;
+	/* vtable index  2 */ virtual uint32_t lia_CALL abiGetCapabilities(const char* pCallerToolchainId) const lia_NOEXCEPT = 0; // kCap... flags; pCallerToolchainId is the caller's lia_TOOLCHAIN_ID
+	/* vtable index  3 */ virtual void*    lia_CALL abiGetNativeObject(const char* pCallerToolchainId, const char* pNativeTypeId) const lia_NOEXCEPT = 0; // see tryNative()
 
 private:
 
@@ -110,6 +114,23 @@ private:
 
 lia_STATIC_ASSERT(sizeof(IBasicString<char>) == sizeof(void*), "Interface must be pure virtual")
 
+//! Returns the TNative string (e.g. std::string) that implements s, if the implementing module was built with the same
+//! toolchain (see lia_TOOLCHAIN_ID) and uses exactly that string type. Returns NULL otherwise.
+template<typename TNative, typename T>
+TNative* tryNative(IBasicString<T>& s) lia_NOEXCEPT {
+	InterfaceVersion version;
+	s.abiGetIBasicStringVersion(version);
+	if ((version.major != 0) || (version.minor < 3)) {
+		return lia_NULLPTR;
+	}
+	return static_cast<TNative*>(s.abiGetNativeObject(lia_TOOLCHAIN_ID, lia::detail::TypeId<TNative>::get()));
+}
+
+template<typename TNative, typename T>
+const TNative* tryNative(const IBasicString<T>& s) lia_NOEXCEPT {
+	return tryNative<TNative>(const_cast<IBasicString<T>&>(s));
+}
+
 typedef lia::IBasicString<char> IString;
 #if lia_HAS_EXPECTED_WCHAR_T_SIZE
 	typedef lia::IBasicString<wchar_t> IWstring;
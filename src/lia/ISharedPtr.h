@@ -116,6 +116,8 @@ void sharedPtrMoveConstructImpl(void* pSrc, void* pDst) {
 //! semver | notes
 //! ------ | --------
 //! 0.1    | Pre-release version
+//! 0.2    | Added abiGetCapabilities()
+//! 0.3    | Added abiGetNativeObject()
 //!
 template<typename T>
 class ISharedPtr: public lia_ISharedPtr_BASE(T) {
@@ -142,6 +144,8 @@ public:
 	/* vtable index 2 */ virtual T*   lia_CALL abiDereference() const lia_NOEXCEPT = 0;
 	/* vtable index 3 */ virtual void lia_CALL abiAssignToNewPtr(T* ptr) lia_NOEXCEPT = 0;
 	/* vtable index 4 */ virtual void lia_CALL abiGetInternal(const void*& pPtr, lia::detail::SharedPtrDerefFunction& pDeref, lia::detail::SharedPtrDestructFunction& pDestruct, lia::detail::SharedPtrCopyConstructFunction& pCopyConstuct, lia::detail::SharedPtrMoveConstructFunction& pMove) const lia_NOEXCEPT = 0;
+	/* vtable index 5 */ virtual uint32_t lia_CALL abiGetCapabilities(const char* pCallerToolchainId) const lia_NOEXCEPT = 0; // kCap... flags; pCallerToolchainId is the caller's lia_TOOLCHAIN_ID
+	/* vtable index 6 */ virtual void*    lia_CALL abiGetNativeObject(const char* pCallerToolchainId, const char* pNativeTypeId) const lia_NOEXCEPT = 0; // see tryNative()
 
 private:
 
@@ -152,6 +156,23 @@ private:
 
 lia_STATIC_ASSERT(sizeof(ISharedPtr<char>) == sizeof(void*), "Interface must be pure virtual")
 
+//! Returns the TNative smart pointer (e.g. std::shared_ptr<T>) that implements p, if the implementing module was built with
+//! the same toolchain (see lia_TOOLCHAIN_ID) and holds exactly that type. Returns NULL otherwise.
+template<typename TNative, typename T>
+TNative* tryNative(ISharedPtr<T>& p) lia_NOEXCEPT {
+	InterfaceVersion version;
+	p.abiGetISharedPtrVersion(version);
+	if ((version.major != 0) || (version.minor < 3)) {
+		return lia_NULLPTR;
+	}
+	return static_cast<TNative*>(p.abiGetNativeObject(lia_TOOLCHAIN_ID, lia::detail::TypeId<TNative>::get()));
+}
+
+template<typename TNative, typename T>
+const TNative* tryNative(const ISharedPtr<T>& p) lia_NOEXCEPT {
+	return tryNative<TNative>(const_cast<ISharedPtr<T>&>(p));
+}
+
 template<typename T>
 class SharedPtrRef lia_FINAL: public ISharedPtr<T> {
 public:
@@ -273,7 +294,7 @@ public:
 
 	virtual void lia_CALL abiGetISharedPtrVersion(InterfaceVersion& v) const lia_NOEXCEPT lia_OVERRIDE {
 		v.major = 0;
-		v.minor = 1;
+		v.minor = 3;
 	}
 
 	virtual void lia_CALL abiDestroy() lia_NOEXCEPT lia_OVERRIDE {
@@ -302,6 +323,19 @@ public:
 		pMoveConstruct = m_pMoveConstruct;
 	}
 
+	virtual uint32_t lia_CALL abiGetCapabilities(const char* pCallerToolchainId) const lia_NOEXCEPT lia_OVERRIDE {
+		return kCapThreadSafeReads | lia::detail::getToolchainCapability(pCallerToolchainId);
+	}
+
+	// The buffer only holds a std::shared_ptr<T> of this module when it was assigned here, not when it was copied from another
+	// module's ISharedPtr<T>
+	virtual void* lia_CALL abiGetNativeObject(const char* pCallerToolchainId, const char* pNativeTypeId) const lia_NOEXCEPT lia_OVERRIDE {
+		if ((m_pDeref != &lia::detail::sharedPtrDerefImpl<std::shared_ptr<T>>) || !lia::detail::isNativeTypeOfCaller<std::shared_ptr<T>>(pCallerToolchainId, pNativeTypeId)) {
+			return lia_NULLPTR;
+		}
+		return const_cast<char*>(m_buf.data);
+	}
+
 private:
 
 	union Data {
@@ -333,7 +367,7 @@ public:
 
 	virtual void lia_CALL abiGetISharedPtrVersion(InterfaceVersion& v) const lia_NOEXCEPT lia_OVERRIDE {
 		v.major = 0;
-		v.minor = 1;
+		v.minor = 3;
 	}
 
 	virtual void lia_CALL abiDestroy() lia_NOEXCEPT lia_OVERRIDE {
@@ -356,6 +390,17 @@ public:
 		pMoveConstruct = &lia::detail::sharedPtrMoveConstructImpl<TSharedPtrValue>;
 	}
 
+	virtual uint32_t lia_CALL abiGetCapabilities(const char* pCallerToolchainId) const lia_NOEXCEPT lia_OVERRIDE {
+		return kCapThreadSafeReads | lia::detail::getToolchainCapability(pCallerToolchainId);
+	}
+
+	virtual void* lia_CALL abiGetNativeObject(const char* pCallerToolchainId, const char* pNativeTypeId) const lia_NOEXCEPT lia_OVERRIDE {
+		if (!lia::detail::isNativeTypeOfCaller<TSharedPtrValue>(pCallerToolchainId, pNativeTypeId)) {
+			return lia_NULLPTR;
+		}
+		return const_cast<TSharedPtrValue*>(&m_ptr);
+	}
+
 private:
 
 	SharedPtrRef(const SharedPtrRef&); // forbidden
@@ -51,6 +51,10 @@ THE SOFTWARE.
 
 #ifdef __cplusplus
 
+#if lia_CPP20_API
+	#include <ranges>
+#endif
+
 namespace lia {
 
 template<typename T>
@@ -62,6 +66,12 @@ class IVector;
 template<typename T>
 class VectorIteratorHandle;
 
+template<typename T>
+class VectorIndexIterator;
+
+template<typename T>
+class VectorView;
+
 template<typename T, typename TVector>
 class VectorRef;
 
@@ -104,6 +114,27 @@ struct MakeTypes< IVector<const T> > {
 	typedef VectorProxy<const T> ConstPointer;
 };
 
+#if lia_CPP11_API
+
+// The operators of std::vector are declared for all element types, but only compile if the elements have them
+template<typename A, typename B>
+struct HasLess< std::vector<A, B> > {
+	static const bool value = HasLess<A>::value;
+};
+
+template<typename A, typename B>
+struct HasEqual< std::vector<A, B> > {
+	static const bool value = HasEqual<A>::value;
+};
+
+#endif
+
+template<typename T>
+struct FlatTypes< IVector<T> > {
+	static const bool isFlattenable = !IsLiaInterface<typename RemoveConst<T>::type>::value;
+	typedef typename IfThenElse<isFlattenable, typename RemoveConst<T>::type, Incomplete>::type Value;
+};
+
 }
 
 #define lia_IVectorIterator_BASE(T) lia::detail::VectorIteratorApiMixin<T, \
@@ -118,6 +149,8 @@ struct MakeTypes< IVector<const T> > {
 //! semver | notes
 //! ------ | --------
 //! 0.1    | Pre-release version
+//! 0.2    | Added abiConstructBase()
+//! 0.3    | Added abiGetCapabilities()
 //!
 template<typename T>
 class IVectorIterator: public lia_IVectorIterator_BASE(T)
@@ -141,6 +174,8 @@ public:
 	/* vtable index  4 */ virtual abi_ptrdiff_t lia_CALL abiGetDistance(const IVectorIterator<T>& other) const lia_NOEXCEPT = 0;
 	/* vtable index  5 */ virtual void          lia_CALL abiAdvance(abi_ptrdiff_t n) lia_NOEXCEPT = 0;
 	/* vtable index  6 */ virtual void          lia_CALL abiDereference(typename lia::detail::MakeTypes<T>::Pointer& pElem, abi_ptrdiff_t i) const lia_NOEXCEPT = 0;
+	/* vtable index  7 */ virtual void          lia_CALL abiConstructBase(void* pBuf, abi_bool_t isConstInterator) const lia_NOEXCEPT = 0; // like abiCloneTo(), but constructs the underlying forward iterator of a reverse iterator
+	/* vtable index  8 */ virtual uint32_t      lia_CALL abiGetCapabilities(const char* pCallerToolchainId) const lia_NOEXCEPT = 0; // kCap... flags; pCallerToolchainId is the caller's lia_TOOLCHAIN_ID
 private:
 
 	typedef lia_IVectorIterator_BASE(T) ApiBase;
@@ -155,6 +190,20 @@ private:
                                                                              typename lia::detail::MakeTypes<T>::Pointer \
                                                                             >
 
+namespace detail {
+
+typedef void (*ConstructIteratorFunction)(const void* pVector, abi_bool_t isConstIterator, void* pBuf);
+
+}
+
+// Iterator over an IVector<T>. The iterator is usually an IVectorIterator<T> implementation which is constructed by the
+// vector inside an in-object buffer, so that each operation is a virtual call.
+// For element types that aren't lia interfaces, VectorIndexIterator<T> creates the handle in "devirtualized" mode instead:
+// The handle then just holds a pointer into the contiguous storage of the vector, and all operations are plain pointer
+// arithmetic. The IVectorIterator<T> implementation is only constructed (and the devirtualized mode is left) when
+// getAbi() is used, because the caller might modify the iterator through the interface afterwards.
+// The const functions of a handle may be called concurrently, except for getAbi() const, the conversion to
+// const IVectorIterator<T>& and capabilities(), which construct the implementation or cache its capabilities.
 template<typename T>
 class VectorIteratorHandle: public lia_VectorIteratorHandle_BASE(T)
 {
@@ -162,11 +211,17 @@ public:
 
 	typedef VectorIteratorHandle<T> ThisType;
 
+	typedef typename lia::detail::MakeTypes<T>::Reference TReference;
+	typedef typename lia::detail::MakeTypes<T>::Pointer   TPointer;
+
+	// Leaves the devirtualized mode like the non-const version, so it's not safe to call concurrently on the same handle
 	const IVectorIterator<T>& getAbi() const lia_NOEXCEPT {
+		const_cast<ThisType&>(*this).materialize();
 		return *reinterpret_cast<const IVectorIterator<T>*>(m_buf.data);
 	}
 
 	IVectorIterator<T>& getAbi() lia_NOEXCEPT {
+		materialize();
 		return *reinterpret_cast<IVectorIterator<T>*>(m_buf.data);
 	}
 
@@ -181,27 +236,26 @@ public:
 	// conversion into const-iterator
 	operator VectorIteratorHandle<const T>() const noexcept {
 		VectorIteratorHandle<const T> result;
-		getAbi().abiCloneTo(result.getBuffer(), abi_true);
-		result.setConstructed();
+		if (m_isDevirtualized) {
+			result.setDevirtualized(m_pVector, m_pConstruct, m_pBegin, m_pElem);
+		}
+		else {
+			getAbi().abiCloneTo(result.getBuffer(), abi_true);
+			result.setConstructed();
+		}
 		return result;
 	}
 
-	VectorIteratorHandle(): m_isConstructed(false), reserved__() {}
+	VectorIteratorHandle(): m_isConstructed(false), m_isDevirtualized(false), m_hasCapabilities(false), reserved__(), m_capabilities(0u), m_pVector(lia_NULLPTR), m_pConstruct(lia_NULLPTR), m_pBegin(lia_NULLPTR), m_pElem(lia_NULLPTR) {}
 
-	VectorIteratorHandle(const VectorIteratorHandle& other): m_isConstructed(false), reserved__() {
-		if (other.m_isConstructed) {
-			other.getAbi().abiCloneTo(m_buf.data, abi_false);
-			m_isConstructed = true;
-		}
+	VectorIteratorHandle(const VectorIteratorHandle& other): m_isConstructed(false), m_isDevirtualized(false), m_hasCapabilities(false), reserved__(), m_capabilities(0u), m_pVector(lia_NULLPTR), m_pConstruct(lia_NULLPTR), m_pBegin(lia_NULLPTR), m_pElem(lia_NULLPTR) {
+		copyFrom(other);
 	}
 
 #if lia_CPP11_API
 
-	VectorIteratorHandle(VectorIteratorHandle&& other) lia_NOEXCEPT: m_isConstructed(false), reserved__() {
-		if (other.m_isConstructed) {
-			other.getAbi().abiMoveTo(m_buf.data);
-			m_isConstructed = true;
-		}
+	VectorIteratorHandle(VectorIteratorHandle&& other) lia_NOEXCEPT: m_isConstructed(false), m_isDevirtualized(false), m_hasCapabilities(false), reserved__(), m_capabilities(0u), m_pVector(lia_NULLPTR), m_pConstruct(lia_NULLPTR), m_pBegin(lia_NULLPTR), m_pElem(lia_NULLPTR) {
+		moveFrom(other);
 	}
 
 #endif
@@ -209,10 +263,7 @@ public:
 	VectorIteratorHandle& operator=(const VectorIteratorHandle& other) {
 		if (&other != this) {
 			detachImpl();
-			if (other.m_isConstructed) {
-				other.getAbi().abiCloneTo(m_buf.data, abi_false);
-				m_isConstructed = true;
-			}
+			copyFrom(other);
 		}
 		return *this;
 	}
@@ -221,10 +272,7 @@ public:
 
 	VectorIteratorHandle& operator=(VectorIteratorHandle&& other) lia_NOEXCEPT {
 		detachImpl();
-		if (other.m_isConstructed) {
-			other.getAbi().abiMoveTo(m_buf.data);
-			m_isConstructed = true;
-		}
+		moveFrom(other);
 		return *this;
 	}
 
@@ -239,320 +287,1472 @@ public:
 	}
 
 	void setConstructed() lia_NOEXCEPT {
-		m_isConstructed = true;
+		m_isConstructed   = true;
+		m_hasCapabilities = false;
+		m_capabilities    = 0u;
 	}
 
-private:
-
-	void detachImpl() {
-		if (m_isConstructed) {
-			getAbi().abiFinalize();
-			m_isConstructed = false;
+	// Returns the kCap... flags of the IVectorIterator<T> implementation. They are queried once and cached in the handle.
+	// In devirtualized mode, a temporary iterator is queried, so that the handle stays devirtualized.
+	uint32_t capabilities() const lia_NOEXCEPT {
+		if (!m_hasCapabilities) {
+			if (m_isDevirtualized) {
+				Data buf;
+				(*m_pConstruct)(m_pVector, abi_true, buf.data);
+				m_capabilities = queryCapabilities(*reinterpret_cast<const IVectorIterator<const T>*>(buf.data));
+				m_hasCapabilities = true;
+				reinterpret_cast<IVectorIterator<const T>*>(buf.data)->abiFinalize();
+			}
+			else if (m_isConstructed) {
+				m_capabilities = queryCapabilities(*reinterpret_cast<const IVectorIterator<T>*>(m_buf.data));
+				m_hasCapabilities = true;
+			}
 		}
+		return m_capabilities;
 	}
 
-	union Data {
-		memalign_t alignmentDummy;
-		char data[lia::detail::kIteratorBufSize];
-	} m_buf;
-	abi_bool_t m_isConstructed;
-	uint8_t reserved__[sizeof(void*)-1];
-};
+	// Switches the handle into devirtualized mode. pConstruct must construct an iterator at the begin of pVector,
+	// which is the vector that pBegin belongs to.
+	void setDevirtualized(const void* pVector, lia::detail::ConstructIteratorFunction pConstruct, T* pBegin, T* pElem) lia_NOEXCEPT {
+		detachImpl();
+		m_isDevirtualized = true;
+		m_pVector         = pVector;
+		m_pConstruct      = pConstruct;
+		m_pBegin          = pBegin;
+		m_pElem           = pElem;
+	}
 
-#undef lia_VectorIteratorHandle_BASE
+	TReference operator*() const {
+		return derefImpl(0, IsContiguousTag());
+	}
 
-#define lia_IVector_BASE(T) lia::detail::VectorApiMixin<T, \
-                                                        lia::IVector<T>, \
-                                                        lia::IVector<T>, \
-                                                        typename lia::detail::MakeTypes<T>::Reference, \
-                                                        typename lia::detail::MakeTypes<T>::Pointer, \
-                                                        typename lia::detail::MakeTypes<T>::ConstReference, \
-                                                        typename lia::detail::MakeTypes<T>::ConstPointer, \
-                                                        VectorIteratorHandle<T>, \
-                                                        VectorIteratorHandle<const T> \
-                                                       >
+	TPointer operator->() const {
+		return arrowImpl(IsContiguousTag());
+	}
 
-//! Interface version history:
-//!
-//! semver | notes
-//! ------ | --------
-//! 0.1    | Pre-release version
-//!
-template<typename T>
-class IVector: public lia_IVector_BASE(T) {
-public:
+	TReference operator[](std::ptrdiff_t i) const {
+		return derefImpl(i, IsContiguousTag());
+	}
 
-  lia_STATIC_ASSERT((!lia::detail::IsSame<T, bool>::value),       "No std::vector<bool> support until now. Will follow in a future revision.")
-  lia_STATIC_ASSERT((!lia::detail::IsSame<T, const bool>::value), "No std::vector<bool> support until now. Will follow in a future revision.")
+	ThisType& operator++() {
+		return (*this += 1);
+	}
 
-	typedef IVector<T> ThisType;
+	ThisType& operator--() {
+		return (*this -= 1);
+	}
 
-	void operator delete(void* p) {
-		if (p != lia_NULLPTR) {
-			static_cast<ThisType*>(p)->abiDestroy();
-		}
+	ThisType operator++(int) {
+		ThisType result = *this;
+		(void)(*this += 1);
+		return result;
 	}
 
-	IVector& getAbi() lia_NOEXCEPT {
-		return *this;
+	ThisType operator--(int) {
+		ThisType result = *this;
+		(void)(*this -= 1);
+		return result;
 	}
 
-	const IVector& getAbi() const lia_NOEXCEPT {
-		return *this;
+	ThisType operator+(std::ptrdiff_t i) const {
+		ThisType result = *this;
+		(void)(result += i);
+		return result;
 	}
 
-	IVector& operator=(const ThisType& u) {
-		(void)this->ApiBase::operator=(u);
-		return *this;
+	ThisType operator-(std::ptrdiff_t i) const {
+		ThisType result = *this;
+		(void)(result -= i);
+		return result;
 	}
 
-	template<typename U>
-	IVector& operator=(const U& u) {
-		(void)this->ApiBase::operator=(u);
-		return *this;
+	std::ptrdiff_t operator-(const ThisType& other) const {
+		return distance(*this, other);
 	}
 
-	/* vtable index  0  */ virtual void       lia_CALL abiGetIVectorVersion(InterfaceVersion& v) const lia_NOEXCEPT = 0;
-	/* vtable index  1  */ virtual void       lia_CALL abiDestroy() lia_NOEXCEPT = 0;
-	/* vtable index  2  */ virtual void       lia_CALL abiClear() lia_NOEXCEPT = 0;
-	/* vtable index  3  */ virtual abi_bool_t lia_CALL abiReserve(abi_size_t n, abi_bool_t shrinkToFit = abi_false) lia_NOEXCEPT = 0;
-	/* vtable index  4  */ virtual abi_bool_t lia_CALL abiInsert(abi_size_t idx, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) lia_NOEXCEPT = 0;
-	/* vtable index  5  */ virtual abi_bool_t lia_CALL abiRemove(abi_size_t idx, abi_size_t n = 1u) lia_NOEXCEPT = 0;
-	/* vtable index  6  */ virtual abi_size_t lia_CALL abiGetSize(abi_size_t* pCapacity = lia_NULLPTR) const lia_NOEXCEPT = 0;
-	/* vtable index  7  */ virtual abi_bool_t lia_CALL abiGetAt(abi_size_t idx, typename lia::detail::MakeTypes<T>::Pointer& pElem) lia_NOEXCEPT = 0;
-	/* vtable index  8  */ virtual abi_bool_t lia_CALL abiGetAtConst(abi_size_t idx, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) const lia_NOEXCEPT = 0;
-	/* vtable index  9  */ virtual void       lia_CALL abiConstructIterator(abi_bool_t atBegin, void* pBuf) lia_NOEXCEPT = 0;
-	/* vtable index  10 */ virtual void       lia_CALL abiConstructConstIterator(abi_bool_t atBegin, void* pBuf) const lia_NOEXCEPT = 0;
+	ThisType& operator+=(std::ptrdiff_t i) {
+		if (m_isDevirtualized) {
+			m_pElem += i;
+			return *this;
+		}
+		return ApiBase::operator+=(i);
+	}
 
-private:
+	ThisType& operator-=(std::ptrdiff_t i) {
+		if (m_isDevirtualized) {
+			m_pElem -= i;
+			return *this;
+		}
+		return ApiBase::operator-=(i);
+	}
 
-	typedef lia_IVector_BASE(T) ApiBase;
-};
+	bool operator==(const ThisType& other) const lia_NOEXCEPT {
+		return (distance(*this, other) == 0);
+	}
 
-#undef lia_IVector_BASE
+	bool operator!=(const ThisType& other) const lia_NOEXCEPT {
+		return !(*this == other);
+	}
 
-lia_STATIC_ASSERT(sizeof(IVector<int>) == sizeof(void*), "Interface must be pure virtual")
+private:
 
-namespace detail {
+	template<typename U>
+	friend class VectorIteratorHandle;
 
-#define lia_VectorProxy_BASE(T) VectorApiMixin<T, \
-                                               VectorProxy<T>, \
-                                               lia::IVector<T>, \
-                                               typename MakeTypes<T>::Reference, \
-                                               typename MakeTypes<T>::Pointer, \
-                                               typename MakeTypes<T>::ConstReference, \
-                                               typename MakeTypes<T>::ConstPointer, \
-                                               VectorIteratorHandle<T>, \
-                                               VectorIteratorHandle<const T> \
-                                              >
+	typedef lia_VectorIteratorHandle_BASE(T) ApiBase;
 
-// Helper to transport any IVector<T> derivate (let's call it TClass)
-// over ABI/DLL borders
-// without need of dynamic memory allocation or yet another pointer indirection.
-// This is used primarily to transport VectorRef<T> instances over DLL boundaries
-// Precondition for usage with TClass is:
-// - TClass is derived by single derivation from IVector<T>
-// - TClass is trivially constructable by just memcpy-ing it from another TClass instance
-// - TClass can be destroyed without invoking any destructor (TClass must not have non-POD members except
-//   for the vtable pointer)
-// - A TClass instance can be moved around in memory (std::memmove) without loosing integrity
-// - The maximum size of a TClass instance is lia::kProxySize bytes
-// This works by constructing and holding the TClass instance inside an aligned in-object buffer
-// of size lia::kProxySize and only accessing it via its base class IVector<T>.
-// This is a helper class, so don't use it directly but only over functions that generate instances
-// of it.
-template<typename T>
-class VectorProxy: public lia_VectorProxy_BASE(T) {
-public:
+	typedef lia::detail::BoolType<!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value> IsContiguousTag;
 
-	VectorProxy<T>* operator->() lia_NOEXCEPT {
-		return this;
+	TReference derefImpl(std::ptrdiff_t i, lia::detail::BoolType<true>) const {
+		if (m_isDevirtualized) {
+			return m_pElem[i];
+		}
+		return ApiBase::operator[](i);
 	}
 
-	const VectorProxy<T>* operator->() const lia_NOEXCEPT {
-		return this;
+	TReference derefImpl(std::ptrdiff_t i, lia::detail::BoolType<false>) const {
+		return ApiBase::operator[](i);
 	}
 
-	IVector<T>& getAbi() lia_NOEXCEPT {
-		return *reinterpret_cast<IVector<T>*>(m_buf.data);
+	TPointer arrowImpl(lia::detail::BoolType<true>) const {
+		if (m_isDevirtualized) {
+			return m_pElem;
+		}
+		return ApiBase::operator->();
 	}
 
-	const IVector<T>& getAbi() const lia_NOEXCEPT {
-		return *reinterpret_cast<const IVector<T>*>(m_buf.data);
+	TPointer arrowImpl(lia::detail::BoolType<false>) const {
+		return ApiBase::operator->();
 	}
 
-	operator IVector<T>&() lia_NOEXCEPT {
-		return getAbi();
+	// Constructs the IVectorIterator<T> implementation at the current position and leaves the devirtualized mode
+	void materialize() lia_NOEXCEPT {
+		if (m_isDevirtualized) {
+			m_isDevirtualized = false;
+			(*m_pConstruct)(m_pVector, lia::detail::IsSame<T, typename lia::detail::RemoveConst<T>::type>::value ? abi_false : abi_true, m_buf.data);
+			m_isConstructed = true;
+			reinterpret_cast<IVectorIterator<T>*>(m_buf.data)->abiAdvance(static_cast<abi_ptrdiff_t>(m_pElem - m_pBegin));
+		}
 	}
 
-	operator const IVector<T>&() const lia_NOEXCEPT {
-		return getAbi();
+	// When only one of the handles is devirtualized, a materialized copy of it is compared, so that the const
+	// operators never modify a handle
+	static std::ptrdiff_t distance(const ThisType& a, const ThisType& b) lia_NOEXCEPT {
+		if (a.m_isDevirtualized && b.m_isDevirtualized) {
+			return a.m_pElem - b.m_pElem;
+		}
+		if (a.m_isDevirtualized) {
+			ThisType materialized(a);
+			return static_cast<std::ptrdiff_t>(materialized.getAbi().abiGetDistance(b.getAbi()));
+		}
+		if (b.m_isDevirtualized) {
+			ThisType materialized(b);
+			return static_cast<std::ptrdiff_t>(a.getAbi().abiGetDistance(materialized.getAbi()));
+		}
+		return static_cast<std::ptrdiff_t>(a.getAbi().abiGetDistance(b.getAbi()));
 	}
 
-	VectorProxy() lia_NOEXCEPT {}
+	void copyFrom(const VectorIteratorHandle& other) {
+		if (other.m_isDevirtualized) {
+			setDevirtualized(other.m_pVector, other.m_pConstruct, other.m_pBegin, other.m_pElem);
+		}
+		else if (other.m_isConstructed) {
+			other.getAbi().abiCloneTo(m_buf.data, abi_false);
+			m_isConstructed = true;
+		}
+		m_hasCapabilities = other.m_hasCapabilities;
+		m_capabilities    = other.m_capabilities;
+	}
 
-	template<typename IVectorDerivate, typename TParam0>
-	void construct(TParam0& p0) lia_NOEXCEPT {
-		lia_STATIC_ASSERT(sizeof(IVectorDerivate) <= sizeof(m_buf), "IVectorDerivate instance can't be placed into internal buffer")
-		new(m_buf.data) IVectorDerivate(p0);
+	void moveFrom(VectorIteratorHandle& other) lia_NOEXCEPT {
+		if (other.m_isDevirtualized) {
+			setDevirtualized(other.m_pVector, other.m_pConstruct, other.m_pBegin, other.m_pElem);
+		}
+		else if (other.m_isConstructed) {
+			other.getAbi().abiMoveTo(m_buf.data);
+			m_isConstructed = true;
+		}
+		m_hasCapabilities = other.m_hasCapabilities;
+		m_capabilities    = other.m_capabilities;
 	}
 
-	template<typename IVectorDerivate, typename TParam0>
-	void construct(const TParam0& p0) lia_NOEXCEPT {
-		lia_STATIC_ASSERT(sizeof(IVectorDerivate) <= sizeof(m_buf), "IVectorDerivate instance can't be placed into internal buffer")
-		new(m_buf.data) IVectorDerivate(p0);
+	void detachImpl() {
+		if (m_isConstructed) {
+			getAbi().abiFinalize();
+			m_isConstructed = false;
+		}
+		m_isDevirtualized = false;
+		m_hasCapabilities = false;
+		m_capabilities    = 0u;
 	}
 
+	// Iterators before version 0.3 don't report their capabilities
 	template<typename U>
-	VectorProxy& operator=(const U& u) {
-		(void)this->ApiBase::operator=(u);
-		return *this;
+	static uint32_t queryCapabilities(const IVectorIterator<U>& iter) lia_NOEXCEPT {
+		InterfaceVersion v;
+		iter.abiGetIVectorIteratorVersion(v);
+		if ((v.major != 0) || (v.minor < 3)) {
+			return 0u;
+		}
+		return iter.abiGetCapabilities(lia_TOOLCHAIN_ID);
 	}
 
-private:
-
-	typedef lia_VectorProxy_BASE(T) ApiBase;
-
 	union Data {
 		memalign_t alignmentDummy;
-		char data[kProxySize];
+		char data[lia::detail::kIteratorBufSize];
 	} m_buf;
+	abi_bool_t m_isConstructed;
+	abi_bool_t m_isDevirtualized;
+	mutable abi_bool_t m_hasCapabilities; // whether m_capabilities is filled
+	uint8_t reserved__[1];
+	mutable uint32_t m_capabilities; // cache of capabilities(), all 32 bits of the kCap... flags
+	const void* m_pVector;
+	lia::detail::ConstructIteratorFunction m_pConstruct;
+	T* m_pBegin;
+	T* m_pElem;
 };
 
-#undef lia_VectorProxy_BASE
+#undef lia_VectorIteratorHandle_BASE
 
-lia_STATIC_ASSERT(sizeof(VectorProxy<int>) == kProxySize, "Class must only contain the m_buf member")
+namespace detail {
 
+// Constructs the forward iterator that a natively reversed iterator (see IVector::abiConstructReverseIterator()) is based on
 template<typename T>
-VectorProxy<T> derefElemPtr(VectorProxy<T>& p) {
-	return p;
+VectorIteratorHandle<T> getReverseBase(const VectorIteratorHandle<T>& iter) {
+	VectorIteratorHandle<T> result;
+	iter.getAbi().abiConstructBase(result.getBuffer(), lia::detail::IsSame<T, typename lia::detail::RemoveConst<T>::type>::value ? abi_false : abi_true);
+	result.setConstructed();
+	return result;
 }
 
-template<typename T>
-VectorProxy<const T> derefElemPtr(VectorProxy<const T>& p) {
-	return p;
 }
 
-template<typename T, typename U, typename V>
-void assignElemPtr(VectorProxy<T>& p, std::vector<U, V>& u) {
-	p.template construct< lia::VectorRef< T, std::vector<U, V>& > >(u);
-}
+// Random access iterator over an IVector<T> that just consists of a pointer to the vector and an index, so that it is
+// trivially copyable and doesn't need to be finalized. This is the iterator type of IVector<T>. Elements are accessed
+// with IVector<T>::abiGetAt(), or directly in the storage of the vector for element types that aren't lia interfaces
+// (the pointer to the storage is held as third member then). Where an IVectorIterator<T> is needed, the iterator
+// converts into a VectorIteratorHandle<T>.
+template<typename T>
+class VectorIndexIterator {
+public:
 
-template<typename T, typename U, typename V>
-void assignElemPtr(VectorProxy<const T>& p, const std::vector<U, V>& u) {
-	p.template construct< lia::VectorRef< const T, std::vector<U, V>& > >(const_cast<std::vector<U, V>&>(u));
-}
+	typedef VectorIndexIterator<T> ThisType;
+	typedef typename lia::detail::RemoveConst<T>::type TNonConst;
+	typedef typename lia::detail::IfThenElse<lia::detail::IsSame<T, TNonConst>::value, IVector<T>, const IVector<TNonConst> >::type TVector;
 
-}
+	// API according to https://en.cppreference.com/w/cpp/iterator/iterator_traits
 
-template<typename T, typename TIterator, typename TConstIterator>
-class VectorIteratorRef lia_FINAL: public IVectorIterator<T> {
-public:
+	typedef std::ptrdiff_t                                difference_type;
+	typedef T                                             value_type;
+	typedef typename lia::detail::MakeTypes<T>::Pointer   pointer;
+	typedef typename lia::detail::MakeTypes<T>::Reference reference;
+	typedef std::random_access_iterator_tag               iterator_category;
 
-	typedef VectorIteratorRef<T, TIterator, TConstIterator> ThisType;
-	typedef VectorIteratorRef<const T, TConstIterator, TConstIterator> ConstThisType;
+	VectorIndexIterator() lia_NOEXCEPT: m_pVector(lia_NULLPTR), m_pData(lia_NULLPTR), m_index(0) {}
 
-	VectorIteratorRef() lia_NOEXCEPT: m_iter() {}
-	explicit VectorIteratorRef(const TIterator& i) lia_NOEXCEPT :m_iter(i) {}
-#if lia_CPP11_API
-	explicit VectorIteratorRef(TIterator&& i) lia_NOEXCEPT :m_iter(std::forward<TIterator>(i)) {}
-#endif
+	VectorIndexIterator(TVector& v, std::ptrdiff_t index) lia_NOEXCEPT: m_pVector(&v), m_pData(lia_NULLPTR), m_index(index) {
+		InterfaceVersion version;
+		v.abiGetIVectorVersion(version);
+		if ((version.major == 0) && (version.minor >= 3)) {
+			getData(v, m_pData, IsContiguousTag());
+		}
+	}
 
-	virtual ~VectorIteratorRef() lia_NOEXCEPT {}
+	// conversion of iterator into const-iterator
+	template<typename U>
+	VectorIndexIterator(const VectorIndexIterator<U>& other, typename lia::detail::EnableIf<lia::detail::IsSame<const U, T>::value>::type* = lia_NULLPTR) lia_NOEXCEPT:
+		m_pVector(other.m_pVector), m_pData(other.m_pData), m_index(other.m_index) {}
 
-	virtual void lia_CALL abiGetIVectorIteratorVersion(InterfaceVersion& v) const lia_NOEXCEPT lia_OVERRIDE {
-		v.major = 0;
-		v.minor = 1;
+	operator VectorIteratorHandle<T>() const lia_NOEXCEPT {
+		VectorIteratorHandle<T> result;
+		toHandle(result);
+		return result;
 	}
 
-	virtual void lia_CALL abiCloneTo(void* pBuf, abi_bool_t isConstIterator) const lia_NOEXCEPT lia_OVERRIDE {
-		if (isConstIterator) {
-			new(pBuf) ConstThisType(m_iter);
-		}
-		else {
-			new(pBuf) ThisType(m_iter);
-		}
+	operator typename lia::detail::IfThenElse<lia::detail::IsSame<T, TNonConst>::value, VectorIteratorHandle<const T>, lia::detail::Incomplete>::type() const lia_NOEXCEPT {
+		VectorIteratorHandle<const T> result;
+		toHandle(result);
+		return result;
 	}
 
-	virtual void lia_CALL abiMoveTo(void* pBuf) lia_NOEXCEPT lia_OVERRIDE {
-		new(pBuf) ThisType(
-#if lia_CPP11_API
-			std::move(m_iter)
-#else
+	reference operator*() const lia_NOEXCEPT {
+		using lia::detail::derefElemPtr; // the overloads for proxies are found by ADL
+		pointer p = getPointer(m_index);
+		return derefElemPtr(p);
+	}
+
+	pointer operator->() const lia_NOEXCEPT {
+		return getPointer(m_index);
+	}
+
+	reference operator[](difference_type i) const lia_NOEXCEPT {
+		using lia::detail::derefElemPtr;
+		pointer p = getPointer(m_index + i);
+		return derefElemPtr(p);
+	}
+
+	ThisType& operator++() lia_NOEXCEPT {
+		++m_index;
+		return *this;
+	}
+
+	ThisType operator++(int) lia_NOEXCEPT {
+		ThisType tmp = *this;
+		++m_index;
+		return tmp;
+	}
+
+	ThisType& operator--() lia_NOEXCEPT {
+		--m_index;
+		return *this;
+	}
+
+	ThisType operator--(int) lia_NOEXCEPT {
+		ThisType tmp = *this;
+		--m_index;
+		return tmp;
+	}
+
+	ThisType& operator+=(difference_type i) lia_NOEXCEPT {
+		m_index += i;
+		return *this;
+	}
+
+	ThisType& operator-=(difference_type i) lia_NOEXCEPT {
+		m_index -= i;
+		return *this;
+	}
+
+	ThisType operator+(difference_type i) const lia_NOEXCEPT {
+		ThisType result = *this;
+		result.m_index += i;
+		return result;
+	}
+
+	friend ThisType operator+(difference_type i, const ThisType& iter) lia_NOEXCEPT {
+		return iter + i;
+	}
+
+	ThisType operator-(difference_type i) const lia_NOEXCEPT {
+		ThisType result = *this;
+		result.m_index -= i;
+		return result;
+	}
+
+	difference_type operator-(const ThisType& other) const lia_NOEXCEPT {
+		return m_index - other.m_index;
+	}
+
+	bool operator==(const ThisType& other) const lia_NOEXCEPT {
+		return m_index == other.m_index;
+	}
+
+	bool operator!=(const ThisType& other) const lia_NOEXCEPT {
+		return m_index != other.m_index;
+	}
+
+	bool operator<(const ThisType& other) const lia_NOEXCEPT {
+		return m_index < other.m_index;
+	}
+
+	bool operator>(const ThisType& other) const lia_NOEXCEPT {
+		return m_index > other.m_index;
+	}
+
+	bool operator<=(const ThisType& other) const lia_NOEXCEPT {
+		return m_index <= other.m_index;
+	}
+
+	bool operator>=(const ThisType& other) const lia_NOEXCEPT {
+		return m_index >= other.m_index;
+	}
+
+	// Mixing with iterator handles of the same vector, e.g. v.end() - handle. Both sides are compared as const handles.
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, difference_type>::type operator-(const ThisType& a, const VectorIteratorHandle<U>& b) {
+		return distance(a, b);
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, difference_type>::type operator-(const VectorIteratorHandle<U>& a, const ThisType& b) {
+		return -distance(b, a);
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator==(const ThisType& a, const VectorIteratorHandle<U>& b) {
+		return distance(a, b) == 0;
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator==(const VectorIteratorHandle<U>& a, const ThisType& b) {
+		return distance(b, a) == 0;
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator!=(const ThisType& a, const VectorIteratorHandle<U>& b) {
+		return distance(a, b) != 0;
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator!=(const VectorIteratorHandle<U>& a, const ThisType& b) {
+		return distance(b, a) != 0;
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator<(const ThisType& a, const VectorIteratorHandle<U>& b) {
+		return distance(a, b) < 0;
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator<(const VectorIteratorHandle<U>& a, const ThisType& b) {
+		return distance(b, a) > 0;
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator>(const ThisType& a, const VectorIteratorHandle<U>& b) {
+		return distance(a, b) > 0;
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator>(const VectorIteratorHandle<U>& a, const ThisType& b) {
+		return distance(b, a) < 0;
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator<=(const ThisType& a, const VectorIteratorHandle<U>& b) {
+		return distance(a, b) <= 0;
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator<=(const VectorIteratorHandle<U>& a, const ThisType& b) {
+		return distance(b, a) >= 0;
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator>=(const ThisType& a, const VectorIteratorHandle<U>& b) {
+		return distance(a, b) >= 0;
+	}
+
+	template<typename U>
+	friend typename lia::detail::EnableIf<lia::detail::IsSame<const U, const TNonConst>::value, bool>::type operator>=(const VectorIteratorHandle<U>& a, const ThisType& b) {
+		return distance(b, a) <= 0;
+	}
+
+private:
+	template<typename U>
+	friend class VectorIndexIterator;
+
+	typedef VectorIteratorHandle<const TNonConst> ConstHandle;
+
+	// Distance a - h; the handle is only converted when it isn't a const handle already
+	static difference_type distance(const ThisType& a, const ConstHandle& h) {
+		ConstHandle handle;
+		a.toHandle(handle);
+		return handle - h;
+	}
+
+	static difference_type distance(const ThisType& a, const VectorIteratorHandle<TNonConst>& h) {
+		return distance(a, ConstHandle(h));
+	}
+
+	typedef lia::detail::BoolType<!lia::detail::IsLiaInterface<TNonConst>::value> IsContiguousTag;
+
+	static void getData(IVector<TNonConst>& v, T*& pData, lia::detail::BoolType<true>) lia_NOEXCEPT {
+		if (!v.abiGetData(pData)) {
+			pData = lia_NULLPTR;
+		}
+	}
+
+	static void getData(const IVector<TNonConst>& v, T*& pData, lia::detail::BoolType<true>) lia_NOEXCEPT {
+		if (!v.abiGetDataConst(pData)) {
+			pData = lia_NULLPTR;
+		}
+	}
+
+	static void getData(const IVector<TNonConst>&, T*&, lia::detail::BoolType<false>) lia_NOEXCEPT {}
+
+	pointer getPointer(std::ptrdiff_t i) const lia_NOEXCEPT {
+		return getPointer(i, IsContiguousTag());
+	}
+
+	pointer getPointer(std::ptrdiff_t i, lia::detail::BoolType<true>) const lia_NOEXCEPT {
+		return (m_pData != lia_NULLPTR) ? (m_pData + i) : getPointer(i, lia::detail::BoolType<false>());
+	}
+
+	pointer getPointer(std::ptrdiff_t i, lia::detail::BoolType<false>) const lia_NOEXCEPT {
+		pointer p = pointer();
+		(void)getAt(*m_pVector, static_cast<abi_size_t>(i), p);
+		return p;
+	}
+
+	static abi_bool_t getAt(IVector<TNonConst>& v, abi_size_t i, pointer& p) lia_NOEXCEPT {
+		return v.abiGetAt(i, p);
+	}
+
+	static abi_bool_t getAt(const IVector<TNonConst>& v, abi_size_t i, pointer& p) lia_NOEXCEPT {
+		return v.abiGetAtConst(i, p);
+	}
+
+	template<typename U>
+	void toHandle(VectorIteratorHandle<U>& result) const lia_NOEXCEPT {
+		if (m_pData != lia_NULLPTR) {
+			result.setDevirtualized(m_pVector, &constructBeginIterator, m_pData, m_pData + m_index);
+		}
+		else {
+			constructBeginIterator(m_pVector, lia::detail::IsSame<U, TNonConst>::value ? abi_false : abi_true, result.getBuffer());
+			result.setConstructed();
+			if (m_index != 0) {
+				result.getAbi().abiAdvance(static_cast<abi_ptrdiff_t>(m_index));
+			}
+		}
+	}
+
+	static void constructBeginIterator(const void* pVector, abi_bool_t isConstIterator, void* pBuf) {
+		const IVector<TNonConst>& rVector = *static_cast<const IVector<TNonConst>*>(pVector);
+		if (isConstIterator) {
+			rVector.abiConstructConstIterator(abi_true, pBuf);
+		}
+		else {
+			const_cast<IVector<TNonConst>&>(rVector).abiConstructIterator(abi_true, pBuf);
+		}
+	}
+
+	TVector*       m_pVector;
+	T*             m_pData;
+	std::ptrdiff_t m_index;
+};
+
+// Non-owning view of the elements of an IVector<T>, like std::span. Elements of types that aren't lia interfaces are
+// accessed through plain pointers into the storage of the vector, which makes the view a contiguous range. For vectors of
+// vectors, the iterators are VectorIndexIterator<T>, and the view is a random access range of proxies.
+// Like iterators, a view is invalidated when the size of the vector changes.
+template<typename T>
+class VectorView {
+public:
+
+	typedef VectorView<T> ThisType;
+	typedef typename lia::detail::RemoveConst<T>::type TNonConst;
+	typedef typename lia::detail::IfThenElse<lia::detail::IsSame<T, TNonConst>::value, IVector<T>, const IVector<TNonConst> >::type TVector;
+	typedef typename lia::detail::IfThenElse<!lia::detail::IsLiaInterface<TNonConst>::value, T*, VectorIndexIterator<T> >::type TIterator;
+
+	typedef TNonConst                                     value_type;
+	typedef std::size_t                                   size_type;
+	typedef std::ptrdiff_t                                difference_type;
+	typedef typename lia::detail::MakeTypes<T>::Reference reference;
+	typedef typename lia::detail::MakeTypes<T>::Pointer   pointer;
+	typedef TIterator                                     iterator;
+	typedef TIterator                                     const_iterator;
+
+	VectorView() lia_NOEXCEPT: m_begin(), m_end() {}
+
+	//! Throws std::logic_error if the implementation doesn't hand out the storage of a vector with non-interface elements
+	explicit VectorView(TVector& v): m_begin(), m_end() {
+		init(v, IsContiguousTag());
+	}
+
+	iterator begin() const lia_NOEXCEPT {
+		return m_begin;
+	}
+
+	iterator end() const lia_NOEXCEPT {
+		return m_end;
+	}
+
+	std::size_t size() const lia_NOEXCEPT {
+		return static_cast<std::size_t>(m_end - m_begin);
+	}
+
+	bool empty() const lia_NOEXCEPT {
+		return (m_begin == m_end);
+	}
+
+	reference operator[](std::size_t i) const lia_NOEXCEPT {
+		return m_begin[static_cast<std::ptrdiff_t>(i)];
+	}
+
+	reference front() const lia_NOEXCEPT {
+		return *m_begin;
+	}
+
+	reference back() const lia_NOEXCEPT {
+		return m_end[-1];
+	}
+
+private:
+
+	typedef lia::detail::BoolType<!lia::detail::IsLiaInterface<TNonConst>::value> IsContiguousTag;
+
+	void init(IVector<TNonConst>& v, lia::detail::BoolType<true>) {
+		T* pData = lia_NULLPTR;
+		abi_size_t size = 0;
+		if (!hasContiguousStorage(v) || !v.abiGetData(pData, &size)) {
+			lia_THROW1(std::logic_error, "VectorView not supported by IVector implementation");
+		}
+		m_begin = pData;
+		m_end   = pData + size;
+	}
+
+	void init(const IVector<TNonConst>& v, lia::detail::BoolType<true>) {
+		T* pData = lia_NULLPTR;
+		abi_size_t size = 0;
+		if (!hasContiguousStorage(v) || !v.abiGetDataConst(pData, &size)) {
+			lia_THROW1(std::logic_error, "VectorView not supported by IVector implementation");
+		}
+		m_begin = pData;
+		m_end   = pData + size;
+	}
+
+	void init(TVector& v, lia::detail::BoolType<false>) lia_NOEXCEPT {
+		m_begin = VectorIndexIterator<T>(v, 0);
+		m_end   = VectorIndexIterator<T>(v, static_cast<std::ptrdiff_t>(v.abiGetSize()));
+	}
+
+	static bool hasContiguousStorage(const IVector<TNonConst>& v) lia_NOEXCEPT {
+		InterfaceVersion version;
+		v.abiGetIVectorVersion(version);
+		return (version.major == 0) && (version.minor >= 3);
+	}
+
+	TIterator m_begin;
+	TIterator m_end;
+};
+
+#define lia_IVector_BASE(T) lia::detail::VectorApiMixin<T, \
+                                                        lia::IVector<T>, \
+                                                        lia::IVector<T>, \
+                                                        typename lia::detail::MakeTypes<T>::Reference, \
+                                                        typename lia::detail::MakeTypes<T>::Pointer, \
+                                                        typename lia::detail::MakeTypes<T>::ConstReference, \
+                                                        typename lia::detail::MakeTypes<T>::ConstPointer, \
+                                                        VectorIndexIterator<T>, \
+                                                        VectorIndexIterator<const T> \
+                                                       >
+
+//! Interface version history:
+//!
+//! semver | notes
+//! ------ | --------
+//! 0.1    | Pre-release version
+//! 0.2    | Added abiInsertRange()
+//! 0.3    | Added abiGetData() and abiGetDataConst()
+//! 0.4    | Added abiGetRange() and abiGetRangeConst()
+//! 0.5    | Added abiInsertFill()
+//! 0.6    | Added abiReserveAdditional()
+//! 0.7    | Added abiResize() and abiPopBack()
+//! 0.8    | Added abiSwap(). It exchanges the storage with implementations of version 0.13 and later, see abiGetNativeObject().
+//! 0.9    | Added abiVisit() and abiVisitConst()
+//! 0.10   | Added abiConstructReverseIterator() and abiConstructReverseConstIterator(). The iterators of implementations of this version are at least of IVectorIterator version 0.2.
+//! 0.11   | Added abiExportFlat() and abiImportFlat()
+//! 0.12   | Added abiGetCapabilities(). The iterators of implementations of this version are at least of IVectorIterator version 0.3.
+//! 0.13   | Added abiGetNativeObject()
+//! 0.14   | Added abiInsertMove()
+//! 0.15   | Added abiSort()
+//! 0.16   | Added abiFind() and abiBinarySearch()
+//! 0.17   | Added abiReduce() and abiHistogram()
+//! 0.18   | Added abiRemoveIf(), abiUnique() and abiKeepMasked()
+//! 0.19   | Added abiGatherConst() and abiScatter()
+//!
+template<typename T>
+class IVector: public lia_IVector_BASE(T) {
+public:
+
+  lia_STATIC_ASSERT((!lia::detail::IsSame<T, bool>::value),       "No std::vector<bool> support until now. Will follow in a future revision.")
+  lia_STATIC_ASSERT((!lia::detail::IsSame<T, const bool>::value), "No std::vector<bool> support until now. Will follow in a future revision.")
+
+	typedef IVector<T> ThisType;
+
+	void operator delete(void* p) {
+		if (p != lia_NULLPTR) {
+			static_cast<ThisType*>(p)->abiDestroy();
+		}
+	}
+
+	IVector& getAbi() lia_NOEXCEPT {
+		return *this;
+	}
+
+	const IVector& getAbi() const lia_NOEXCEPT {
+		return *this;
+	}
+
+	IVector& operator=(const ThisType& u) {
+		(void)this->ApiBase::operator=(u);
+		return *this;
+	}
+
+#if lia_CPP11_API
+
+	IVector& operator=(ThisType&& u) {
+		(void)this->ApiBase::operator=(std::move(u));
+		return *this;
+	}
+
+#endif
+
+	template<typename U>
+	IVector& operator=(const U& u) {
+		(void)this->ApiBase::operator=(u);
+		return *this;
+	}
+
+	/* vtable index  0  */ virtual void       lia_CALL abiGetIVectorVersion(InterfaceVersion& v) const lia_NOEXCEPT = 0;
+	/* vtable index  1  */ virtual void       lia_CALL abiDestroy() lia_NOEXCEPT = 0;
+	/* vtable index  2  */ virtual void       lia_CALL abiClear() lia_NOEXCEPT = 0;
+	/* vtable index  3  */ virtual abi_bool_t lia_CALL abiReserve(abi_size_t n, abi_bool_t shrinkToFit = abi_false) lia_NOEXCEPT = 0;
+	/* vtable index  4  */ virtual abi_bool_t lia_CALL abiInsert(abi_size_t idx, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) lia_NOEXCEPT = 0;
+	/* vtable index  5  */ virtual abi_bool_t lia_CALL abiRemove(abi_size_t idx, abi_size_t n = 1u) lia_NOEXCEPT = 0;
+	/* vtable index  6  */ virtual abi_size_t lia_CALL abiGetSize(abi_size_t* pCapacity = lia_NULLPTR) const lia_NOEXCEPT = 0;
+	/* vtable index  7  */ virtual abi_bool_t lia_CALL abiGetAt(abi_size_t idx, typename lia::detail::MakeTypes<T>::Pointer& pElem) lia_NOEXCEPT = 0;
+	/* vtable index  8  */ virtual abi_bool_t lia_CALL abiGetAtConst(abi_size_t idx, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) const lia_NOEXCEPT = 0;
+	/* vtable index  9  */ virtual void       lia_CALL abiConstructIterator(abi_bool_t atBegin, void* pBuf) lia_NOEXCEPT = 0;
+	/* vtable index  10 */ virtual void       lia_CALL abiConstructConstIterator(abi_bool_t atBegin, void* pBuf) const lia_NOEXCEPT = 0;
+	/* vtable index  11 */ virtual abi_bool_t lia_CALL abiInsertRange(abi_size_t idx, typename lia::detail::MakeTypes<T>::ConstPointer* pElems, abi_size_t n) lia_NOEXCEPT = 0;
+	/* vtable index  12 */ virtual abi_bool_t lia_CALL abiGetData(T*& pData, abi_size_t* pSize = lia_NULLPTR, abi_size_t* pCapacity = lia_NULLPTR) lia_NOEXCEPT = 0;
+	/* vtable index  13 */ virtual abi_bool_t lia_CALL abiGetDataConst(const T*& pData, abi_size_t* pSize = lia_NULLPTR, abi_size_t* pCapacity = lia_NULLPTR) const lia_NOEXCEPT = 0;
+	/* vtable index  14 */ virtual abi_bool_t lia_CALL abiGetRange(abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::Pointer* pElems) lia_NOEXCEPT = 0;
+	/* vtable index  15 */ virtual abi_bool_t lia_CALL abiGetRangeConst(abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer* pElems) const lia_NOEXCEPT = 0;
+	/* vtable index  16 */ virtual abi_bool_t lia_CALL abiInsertFill(abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) lia_NOEXCEPT = 0;
+	/* vtable index  17 */ virtual abi_bool_t lia_CALL abiReserveAdditional(abi_size_t n, uint32_t growthPercent = kGrowthDefault) lia_NOEXCEPT = 0;
+	/* vtable index  18 */ virtual abi_bool_t lia_CALL abiResize(abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer* pValue = lia_NULLPTR) lia_NOEXCEPT = 0;
+	/* vtable index  19 */ virtual abi_bool_t lia_CALL abiPopBack() lia_NOEXCEPT = 0;
+	/* vtable index  20 */ virtual abi_bool_t lia_CALL abiSwap(IVector<T>& other) lia_NOEXCEPT = 0;
+	/* vtable index  21 */ virtual abi_bool_t lia_CALL abiVisit(abi_size_t idx, abi_size_t n, typename lia::detail::VisitTypes<T>::Function pFunc, void* pContext) lia_NOEXCEPT = 0;
+	/* vtable index  22 */ virtual abi_bool_t lia_CALL abiVisitConst(abi_size_t idx, abi_size_t n, typename lia::detail::VisitTypes<T>::ConstFunction pFunc, void* pContext) const lia_NOEXCEPT = 0;
+	/* vtable index  23 */ virtual void       lia_CALL abiConstructReverseIterator(abi_bool_t atBegin, void* pBuf) lia_NOEXCEPT = 0;
+	/* vtable index  24 */ virtual void       lia_CALL abiConstructReverseConstIterator(abi_bool_t atBegin, void* pBuf) const lia_NOEXCEPT = 0;
+	/* vtable index  25 */ virtual abi_bool_t lia_CALL abiExportFlat(abi_size_t* pOffsets, typename lia::detail::FlatTypes<T>::Value* pValues, abi_size_t* pNumValues) const lia_NOEXCEPT = 0;
+	/* vtable index  26 */ virtual abi_bool_t lia_CALL abiImportFlat(const abi_size_t* pOffsets, abi_size_t numRows, const typename lia::detail::FlatTypes<T>::Value* pValues) lia_NOEXCEPT = 0;
+	/* vtable index  27 */ virtual uint32_t   lia_CALL abiGetCapabilities(const char* pCallerToolchainId) const lia_NOEXCEPT = 0; // kCap... flags; pCallerToolchainId is the caller's lia_TOOLCHAIN_ID
+	/* vtable index  28 */ virtual void*      lia_CALL abiGetNativeObject(const char* pCallerToolchainId, const char* pNativeTypeId) const lia_NOEXCEPT = 0; // see tryNative()
+	/* vtable index  29 */ virtual abi_bool_t lia_CALL abiInsertMove(abi_size_t idx, typename lia::detail::MakeTypes<T>::Pointer& pElem) lia_NOEXCEPT = 0; // like abiInsert(), but may leave *pElem in a valid, unspecified state
+	/* vtable index  30 */ virtual abi_bool_t lia_CALL abiSort(uint32_t algorithm, abi_size_t middle, typename lia::detail::CompareTypes<T>::Function pLess, void* pContext, uint32_t numThreads) lia_NOEXCEPT = 0; // kSort... algorithm; operator< if pLess is NULL
+	/* vtable index  31 */ virtual abi_bool_t lia_CALL abiFind(uint32_t algorithm, abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer& pValue, typename lia::detail::PredicateTypes<T>::Function pPred, void* pContext, abi_size_t* pResult) const lia_NOEXCEPT = 0; // kSearchFind or kSearchCount; operator== with *pValue if pPred is NULL
+	/* vtable index  32 */ virtual abi_bool_t lia_CALL abiBinarySearch(uint32_t algorithm, abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer& pValue, typename lia::detail::CompareTypes<T>::Function pLess, void* pContext, abi_size_t* pResult) const lia_NOEXCEPT = 0; // kSearch...Bound or kSearchEqualRange; operator< if pLess is NULL
+	/* vtable index  33 */ virtual abi_bool_t lia_CALL abiReduce(uint32_t operation, abi_size_t idx, abi_size_t n, const IVector<T>* pOther, void* pResult) const lia_NOEXCEPT = 0; // kReduce... operation on arithmetic types with ReduceTypes<T>::isAbiFixed; pOther is the second vector for kReduceDot
+	/* vtable index  34 */ virtual abi_bool_t lia_CALL abiHistogram(abi_size_t idx, abi_size_t n, double lower, double upper, abi_size_t numBins, abi_size_t* pCounts) const lia_NOEXCEPT = 0; // numBins bins of equal width over [lower, upper)
+	/* vtable index  35 */ virtual abi_bool_t lia_CALL abiRemoveIf(abi_size_t idx, abi_size_t n, typename lia::detail::PredicateTypes<T>::Function pPred, void* pContext, abi_size_t* pNumRemoved) lia_NOEXCEPT = 0;
+	/* vtable index  36 */ virtual abi_bool_t lia_CALL abiUnique(abi_size_t idx, abi_size_t n, typename lia::detail::CompareTypes<T>::Function pEqual, void* pContext, abi_size_t* pNumRemoved) lia_NOEXCEPT = 0; // operator== if pEqual is NULL
+	/* vtable index  37 */ virtual abi_bool_t lia_CALL abiKeepMasked(const uint8_t* pMask, abi_size_t maskSize, uint32_t maskFormat, abi_size_t* pNumRemoved) lia_NOEXCEPT = 0; // kMask... format, maskSize bytes covering all elements
+	/* vtable index  38 */ virtual abi_bool_t lia_CALL abiGatherConst(const abi_size_t* pIndices, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer* pElems) const lia_NOEXCEPT = 0; // pElems[i] points to the element at pIndices[i]
+	/* vtable index  39 */ virtual abi_bool_t lia_CALL abiScatter(const abi_size_t* pIndices, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer* pElems) lia_NOEXCEPT = 0; // assigns *pElems[i] to the element at pIndices[i]
+
+protected:
+
+#if lia_CPP11_API
+
+	// The move assignment operator above would delete these, which implementations like VectorRef need for copying
+	IVector() = default;
+	IVector(const IVector&) = default;
+	IVector(IVector&&) = default;
+
+#endif
+
+private:
+
+	typedef lia_IVector_BASE(T) ApiBase;
+};
+
+#undef lia_IVector_BASE
+
+lia_STATIC_ASSERT(sizeof(IVector<int>) == sizeof(void*), "Interface must be pure virtual")
+
+template<typename T>
+void swap(IVector<T>& a, IVector<T>& b) {
+	a.swap(b);
+}
+
+//! Returns the TNative container (e.g. std::vector<T>) that implements v, if the implementing module was built with the
+//! same toolchain (see lia_TOOLCHAIN_ID) and uses exactly that container type. Returns NULL otherwise, and for implementations
+//! before IVector version 0.13. The container can then be used directly, without virtual calls, as long as v exists.
+template<typename TNative, typename T>
+TNative* tryNative(IVector<T>& v) lia_NOEXCEPT {
+	InterfaceVersion version;
+	v.abiGetIVectorVersion(version);
+	if ((version.major != 0) || (version.minor < 13)) {
+		return lia_NULLPTR;
+	}
+	return static_cast<TNative*>(v.abiGetNativeObject(lia_TOOLCHAIN_ID, lia::detail::TypeId<TNative>::get()));
+}
+
+template<typename TNative, typename T>
+const TNative* tryNative(const IVector<T>& v) lia_NOEXCEPT {
+	return tryNative<TNative>(const_cast<IVector<T>&>(v));
+}
+
+namespace detail {
+
+#define lia_VectorProxy_BASE(T) VectorApiMixin<T, \
+                                               VectorProxy<T>, \
+                                               lia::IVector<T>, \
+                                               typename MakeTypes<T>::Reference, \
+                                               typename MakeTypes<T>::Pointer, \
+                                               typename MakeTypes<T>::ConstReference, \
+                                               typename MakeTypes<T>::ConstPointer, \
+                                               VectorIteratorHandle<T>, \
+                                               VectorIteratorHandle<const T> \
+                                              >
+
+// Helper to transport any IVector<T> derivate (let's call it TClass)
+// over ABI/DLL borders
+// without need of dynamic memory allocation or yet another pointer indirection.
+// This is used primarily to transport VectorRef<T> instances over DLL boundaries
+// Precondition for usage with TClass is:
+// - TClass is derived by single derivation from IVector<T>
+// - TClass is trivially constructable by just memcpy-ing it from another TClass instance
+// - TClass can be destroyed without invoking any destructor (TClass must not have non-POD members except
+//   for the vtable pointer)
+// - A TClass instance can be moved around in memory (std::memmove) without loosing integrity
+// - The maximum size of a TClass instance is lia::kProxySize bytes
+// This works by constructing and holding the TClass instance inside an aligned in-object buffer
+// of size lia::kProxySize and only accessing it via its base class IVector<T>.
+// This is a helper class, so don't use it directly but only over functions that generate instances
+// of it.
+template<typename T>
+class VectorProxy: public lia_VectorProxy_BASE(T) {
+public:
+
+	VectorProxy<T>* operator->() lia_NOEXCEPT {
+		return this;
+	}
+
+	const VectorProxy<T>* operator->() const lia_NOEXCEPT {
+		return this;
+	}
+
+	IVector<T>& getAbi() lia_NOEXCEPT {
+		return *reinterpret_cast<IVector<T>*>(m_buf.data);
+	}
+
+	const IVector<T>& getAbi() const lia_NOEXCEPT {
+		return *reinterpret_cast<const IVector<T>*>(m_buf.data);
+	}
+
+	operator IVector<T>&() lia_NOEXCEPT {
+		return getAbi();
+	}
+
+	operator const IVector<T>&() const lia_NOEXCEPT {
+		return getAbi();
+	}
+
+	VectorProxy() lia_NOEXCEPT {}
+
+	template<typename IVectorDerivate, typename TParam0>
+	void construct(TParam0& p0) lia_NOEXCEPT {
+		lia_STATIC_ASSERT(sizeof(IVectorDerivate) <= sizeof(m_buf), "IVectorDerivate instance can't be placed into internal buffer")
+		new(m_buf.data) IVectorDerivate(p0);
+	}
+
+	template<typename IVectorDerivate, typename TParam0>
+	void construct(const TParam0& p0) lia_NOEXCEPT {
+		lia_STATIC_ASSERT(sizeof(IVectorDerivate) <= sizeof(m_buf), "IVectorDerivate instance can't be placed into internal buffer")
+		new(m_buf.data) IVectorDerivate(p0);
+	}
+
+	template<typename U>
+	VectorProxy& operator=(const U& u) {
+		(void)this->ApiBase::operator=(u);
+		return *this;
+	}
+
+private:
+
+	typedef lia_VectorProxy_BASE(T) ApiBase;
+
+	union Data {
+		memalign_t alignmentDummy;
+		char data[kProxySize];
+	} m_buf;
+};
+
+#undef lia_VectorProxy_BASE
+
+lia_STATIC_ASSERT(sizeof(VectorProxy<int>) == kProxySize, "Class must only contain the m_buf member")
+
+template<typename T>
+VectorProxy<T> derefElemPtr(VectorProxy<T>& p) {
+	return p;
+}
+
+template<typename T>
+VectorProxy<const T> derefElemPtr(VectorProxy<const T>& p) {
+	return p;
+}
+
+template<typename T, typename U, typename V>
+void assignElemPtr(VectorProxy<T>& p, std::vector<U, V>& u) {
+	p.template construct< lia::VectorRef< T, std::vector<U, V>& > >(u);
+}
+
+template<typename T, typename U, typename V>
+void assignElemPtr(VectorProxy<const T>& p, const std::vector<U, V>& u) {
+	p.template construct< lia::VectorRef< const T, std::vector<U, V>& > >(const_cast<std::vector<U, V>&>(u));
+}
+
+}
+
+namespace detail {
+
+// Inserts the element pElem points to at position i of v, moving from it
+template<bool isInterface>
+struct MoveElement {
+	template<typename TVector, typename TPointer>
+	static void insert(TVector& v, std::size_t i, TPointer& pElem) {
+#if lia_CPP11_API
+		v.insert(v.begin() + i, std::move(*pElem));
+#else
+		v.insert(v.begin() + i, *pElem);
+#endif
+	}
+};
+
+// Interface elements can only be moved from when they're implemented on top of the same container type by a module
+// that was built with the same toolchain. They are copied otherwise.
+template<>
+struct MoveElement<true> {
+	template<typename TVector, typename TPointer>
+	static void insert(TVector& v, std::size_t i, TPointer& pElem) {
+		typedef typename TVector::value_type TValue;
+		TValue* pNative = lia::tryNative<TValue>(pElem.getAbi());
+		if (pNative != lia_NULLPTR) {
+#if lia_CPP11_API
+			v.insert(v.begin() + i, std::move(*pNative));
+#else
+			v.insert(v.begin() + i, *pNative);
+#endif
+		}
+		else {
+			v.insert(v.begin() + i, derefElemPtr(pElem));
+		}
+	}
+};
+
+// Hands out the storage of a std::vector when its elements have the same layout on both sides of the ABI
+// boundary, which is the case for all element types except lia interfaces.
+template<bool isContiguous>
+struct ContiguousData {
+	template<typename T, typename TVector>
+	static abi_bool_t get(T*& pData, TVector& v) lia_NOEXCEPT {
+		pData = v.empty() ? lia_NULLPTR : &v[0];
+		return abi_true;
+	}
+};
+
+template<>
+struct ContiguousData<false> {
+	template<typename T, typename TVector>
+	static abi_bool_t get(T*& pData, TVector&) lia_NOEXCEPT {
+		pData = lia_NULLPTR;
+		return abi_false;
+	}
+};
+
+// The forward iterator type that an iterator of the vector implementation is based on
+template<typename TIter>
+struct BaseIterator {
+	typedef TIter Type;
+	static TIter get(const TIter& iter) {
+		return iter;
+	}
+};
+
+template<typename TIter>
+struct BaseIterator< std::reverse_iterator<TIter> > {
+	typedef TIter Type;
+	static TIter get(const std::reverse_iterator<TIter>& iter) {
+		return iter.base();
+	}
+};
+
+// Conversion of a std::vector of std::vectors from and to compressed sparse row format
+template<bool isFlattenable>
+struct FlatAccess {
+	template<typename TVector, typename TValue>
+	static abi_bool_t exportTo(const TVector&, abi_size_t*, TValue*, abi_size_t* pNumValues) lia_NOEXCEPT {
+		if (pNumValues != lia_NULLPTR) {
+			*pNumValues = 0;
+		}
+		return abi_false;
+	}
+
+	template<typename TVector, typename TValue>
+	static abi_bool_t importFrom(TVector&, const abi_size_t*, abi_size_t, const TValue*) lia_NOEXCEPT {
+		return abi_false;
+	}
+};
+
+template<>
+struct FlatAccess<true> {
+	template<typename TVector, typename TValue>
+	static abi_bool_t exportTo(const TVector& v, abi_size_t* pOffsets, TValue* pValues, abi_size_t* pNumValues) lia_NOEXCEPT {
+		if (pNumValues == lia_NULLPTR) {
+			return abi_false;
+		}
+		std::size_t numValues = 0;
+		for (std::size_t i=0; i<v.size(); ++i) {
+			numValues += v[i].size();
+		}
+		const abi_size_t capacity = *pNumValues;
+		*pNumValues = static_cast<abi_size_t>(numValues);
+		if (pOffsets == lia_NULLPTR) {
+			return abi_true;
+		}
+		if (capacity < numValues) {
+			return abi_false;
+		}
+		std::size_t offset = 0;
+		for (std::size_t i=0; i<v.size(); ++i) {
+			pOffsets[i] = static_cast<abi_size_t>(offset);
+			std::copy(v[i].begin(), v[i].end(), pValues + offset);
+			offset += v[i].size();
+		}
+		pOffsets[v.size()] = static_cast<abi_size_t>(offset);
+		return abi_true;
+	}
+
+	template<typename TVector, typename TValue>
+	static abi_bool_t importFrom(TVector& v, const abi_size_t* pOffsets, abi_size_t numRows, const TValue* pValues) lia_NOEXCEPT {
+		typedef typename RemoveReference<TVector>::type TStorage;
+		const std::size_t n = static_cast<std::size_t>(numRows);
+		for (std::size_t i=0; i<n; ++i) {
+			if (pOffsets[i] > pOffsets[i + 1]) {
+				return abi_false;
+			}
+		}
+		lia_TRY
+			TStorage tmp(n);
+			for (std::size_t i=0; i<n; ++i) {
+				tmp[i].assign(pValues + pOffsets[i], pValues + pOffsets[i + 1]);
+			}
+			v.swap(tmp);
+		lia_CATCHALL(return abi_false)
+		return abi_true;
+	}
+};
+
+// Passes the elements [idx, idx + n) of a std::vector to a visitor callback: contiguous elements all at once,
+// lia interfaces in chunks of proxies of type TElemPtr.
+template<bool isContiguous>
+struct VisitRange {
+	template<typename TElemPtr, typename TFunction, typename TVector>
+	static abi_bool_t visit(TFunction pFunc, void* pContext, TVector& v, std::size_t idx, std::size_t n) lia_NOEXCEPT {
+		if (n == 0) {
+			return abi_true;
+		}
+		return (*pFunc)(pContext, &v[idx], static_cast<abi_size_t>(n));
+	}
+};
+
+template<>
+struct VisitRange<false> {
+	template<typename TElemPtr, typename TFunction, typename TVector>
+	static abi_bool_t visit(TFunction pFunc, void* pContext, TVector& v, std::size_t idx, std::size_t n) lia_NOEXCEPT {
+		TElemPtr chunk[kChunkSize];
+		for (std::size_t i=0; i<n; i += kChunkSize) {
+			const std::size_t num = std::min(kChunkSize, n - i);
+			for (std::size_t j=0; j<num; ++j) {
+				assignElemPtr(chunk[j], v[idx + i + j]);
+			}
+			if (!(*pFunc)(pContext, chunk, static_cast<abi_size_t>(num))) {
+				return abi_false;
+			}
+		}
+		return abi_true;
+	}
+};
+
+}
+
+template<typename T, typename TIterator, typename TConstIterator>
+class VectorIteratorRef lia_FINAL: public IVectorIterator<T> {
+public:
+
+	typedef VectorIteratorRef<T, TIterator, TConstIterator> ThisType;
+	typedef VectorIteratorRef<const T, TConstIterator, TConstIterator> ConstThisType;
+
+	VectorIteratorRef() lia_NOEXCEPT: m_iter() {}
+	explicit VectorIteratorRef(const TIterator& i) lia_NOEXCEPT :m_iter(i) {}
+#if lia_CPP11_API
+	explicit VectorIteratorRef(TIterator&& i) lia_NOEXCEPT :m_iter(std::forward<TIterator>(i)) {}
+#endif
+
+	virtual ~VectorIteratorRef() lia_NOEXCEPT {}
+
+	virtual void lia_CALL abiGetIVectorIteratorVersion(InterfaceVersion& v) const lia_NOEXCEPT lia_OVERRIDE {
+		v.major = 0;
+		v.minor = 3;
+	}
+
+	virtual void lia_CALL abiCloneTo(void* pBuf, abi_bool_t isConstIterator) const lia_NOEXCEPT lia_OVERRIDE {
+		if (isConstIterator) {
+			new(pBuf) ConstThisType(m_iter);
+		}
+		else {
+			new(pBuf) ThisType(m_iter);
+		}
+	}
+
+	virtual void lia_CALL abiMoveTo(void* pBuf) lia_NOEXCEPT lia_OVERRIDE {
+		new(pBuf) ThisType(
+#if lia_CPP11_API
+			std::move(m_iter)
+#else
 			m_iter
 #endif
 		);
 	}
 
-	virtual void lia_CALL abiFinalize() lia_NOEXCEPT lia_OVERRIDE {
-		m_iter.~TIterator();
+	virtual void lia_CALL abiFinalize() lia_NOEXCEPT lia_OVERRIDE {
+		m_iter.~TIterator();
+	}
+
+	virtual abi_ptrdiff_t lia_CALL abiGetDistance(const IVectorIterator<T>& other_) const lia_NOEXCEPT lia_OVERRIDE {
+		const ThisType& other = static_cast<const ThisType&>(other_);
+		return static_cast<abi_ptrdiff_t>(m_iter - other.m_iter);
+	}
+
+	virtual void lia_CALL abiAdvance(abi_ptrdiff_t n) lia_NOEXCEPT lia_OVERRIDE {
+		m_iter += static_cast<std::ptrdiff_t>(n);
+	}
+
+	virtual void lia_CALL abiDereference(typename lia::detail::MakeTypes<T>::Pointer& pElem, abi_ptrdiff_t i) const lia_NOEXCEPT lia_OVERRIDE {
+		lia::detail::assignElemPtr(pElem, m_iter[static_cast<std::ptrdiff_t>(i)]);
+	}
+
+	virtual void lia_CALL abiConstructBase(void* pBuf, abi_bool_t isConstIterator) const lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::BaseIterator<TIterator>::Type      TBaseIterator;
+		typedef typename lia::detail::BaseIterator<TConstIterator>::Type TBaseConstIterator;
+		if (isConstIterator) {
+			new(pBuf) VectorIteratorRef<const T, TBaseConstIterator, TBaseConstIterator>(lia::detail::BaseIterator<TIterator>::get(m_iter));
+		}
+		else {
+			new(pBuf) VectorIteratorRef<T, TBaseIterator, TBaseConstIterator>(lia::detail::BaseIterator<TIterator>::get(m_iter));
+		}
+	}
+
+	// The elements are contiguous for forward iterators only, the ones of reverse iterators are in descending order
+	virtual uint32_t lia_CALL abiGetCapabilities(const char* pCallerToolchainId) const lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::RemoveConst<T>::type TNonConst;
+		uint32_t caps = kCapThreadSafeReads | lia::detail::getToolchainCapability(pCallerToolchainId);
+		if (!lia::detail::IsLiaInterface<TNonConst>::value && lia::detail::IsSame<typename lia::detail::BaseIterator<TIterator>::Type, TIterator>::value) {
+			caps |= kCapContiguousStorage;
+		}
+		if (lia::detail::IsTriviallyRelocatable<TNonConst>::value) {
+			caps |= kCapTriviallyRelocatable;
+		}
+		return caps;
+	}
+
+private:
+	TIterator  m_iter;
+};
+
+template<typename T, typename TVector>
+class VectorRef lia_FINAL: public IVector<T> {
+public:
+
+	typedef VectorRef<T, TVector> ThisType;
+
+	VectorRef() lia_NOEXCEPT {}
+	explicit VectorRef(TVector& v) lia_NOEXCEPT :m_vector(v) {}
+	virtual ~VectorRef() lia_NOEXCEPT {}
+
+	void operator delete(void* p) {
+		::operator delete(p);
+	}
+
+	virtual void lia_CALL abiGetIVectorVersion(InterfaceVersion& v) const lia_NOEXCEPT lia_OVERRIDE {
+		v.major = 0;
+		v.minor = 19;
+	}
+
+	virtual void lia_CALL abiDestroy() lia_NOEXCEPT lia_OVERRIDE {
+		delete this;
+	}
+
+	virtual void lia_CALL abiClear() lia_NOEXCEPT lia_OVERRIDE {
+		m_vector.clear();
+	}
+
+	virtual abi_bool_t lia_CALL abiReserve(abi_size_t n, abi_bool_t shrinkToFit = abi_false) lia_NOEXCEPT lia_OVERRIDE {
+		if (n > 0) {
+			lia_TRY
+				m_vector.reserve(static_cast<std::size_t>(n));
+			lia_CATCHALL(return abi_false)
+		}
+#if lia_CPP11_API
+		if (shrinkToFit) {
+			lia_TRY
+				m_vector.shrink_to_fit();
+			lia_CATCHALL(return abi_false)
+		}
+#endif
+		return abi_true;
+	}
+
+	virtual abi_bool_t lia_CALL abiInsert(abi_size_t idx, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i = static_cast<std::size_t>(idx);
+		lia_TRY
+			if (i <= m_vector.size()) {
+				m_vector.insert(m_vector.begin() + i, lia::detail::derefElemPtr(pElem));
+			}
+			else {
+				return abi_false;
+			}
+		lia_CATCHALL(return abi_false)
+		return abi_true;
+	}
+
+	virtual abi_bool_t lia_CALL abiRemove(abi_size_t idx, abi_size_t n = 1u) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i   = static_cast<std::size_t>(idx);
+		const std::size_t num = static_cast<std::size_t>(n);
+		if (i >= m_vector.size()) {
+			return abi_false;
+		}
+		lia_TRY
+				m_vector.erase(m_vector.begin() + i, m_vector.begin() + i + num);
+		lia_CATCHALL(return abi_false)
+		return abi_true;
+	}
+
+	virtual abi_size_t lia_CALL abiGetSize(abi_size_t* pCapacity = lia_NULLPTR) const lia_NOEXCEPT lia_OVERRIDE {
+		if (pCapacity != lia_NULLPTR) {
+			*pCapacity = static_cast<abi_size_t>(m_vector.capacity());
+		}
+		return static_cast<abi_size_t>(m_vector.size());
+	}
+
+	virtual abi_bool_t lia_CALL abiGetAt(abi_size_t idx, typename lia::detail::MakeTypes<T>::Pointer& pElem) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i = static_cast<std::size_t>(idx);
+		if (i < m_vector.size()) {
+			lia::detail::assignElemPtr(pElem, m_vector[i]);
+			return abi_true;
+		}
+		return abi_false;
+	}
+
+	virtual abi_bool_t lia_CALL abiGetAtConst(abi_size_t idx, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) const lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i = static_cast<std::size_t>(idx);
+		if (i < m_vector.size()) {
+			lia::detail::assignElemPtr(pElem, m_vector[i]);
+			return abi_true;
+		}
+		return abi_false;
+	}
+
+	virtual void lia_CALL abiConstructIterator(abi_bool_t atBegin, void* pBuf) lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::RemoveReference<TVector>::type::iterator TIterator;
+		typedef typename lia::detail::RemoveReference<TVector>::type::const_iterator TConstIterator;
+		new (pBuf) VectorIteratorRef<T, TIterator, TConstIterator>(atBegin ? m_vector.begin() : m_vector.end());
+	}
+
+	virtual void lia_CALL abiConstructConstIterator(abi_bool_t atBegin, void* pBuf) const lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::RemoveReference<TVector>::type::const_iterator TConstIterator;
+		new (pBuf) VectorIteratorRef<const T, TConstIterator, TConstIterator>(atBegin ? m_vector.begin() : m_vector.end());
+	}
+
+	virtual abi_bool_t lia_CALL abiInsertRange(abi_size_t idx, typename lia::detail::MakeTypes<T>::ConstPointer* pElems, abi_size_t n) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i       = static_cast<std::size_t>(idx);
+		const std::size_t num     = static_cast<std::size_t>(n);
+		const std::size_t oldSize = m_vector.size();
+		if (i > oldSize) {
+			return abi_false;
+		}
+		// Append at the end and rotate the new elements into place afterwards, so the tail is only
+		// shifted once per call instead of once per element. Until the rotation, a failure is undone
+		// by removing the appended elements.
+		lia_TRY
+			for (std::size_t j=0; j<num; ++j) {
+				m_vector.push_back(lia::detail::derefElemPtr(pElems[j]));
+			}
+		lia_CATCHALL(m_vector.erase(m_vector.begin() + oldSize, m_vector.end()); return abi_false)
+		if (i < oldSize) {
+			// Can only throw for elements with throwing move operations, which leaves them in unspecified
+			// order like std::vector::insert() does
+			lia_TRY
+				std::rotate(m_vector.begin() + i, m_vector.begin() + oldSize, m_vector.end());
+			lia_CATCHALL(return abi_false)
+		}
+		return abi_true;
+	}
+
+	virtual abi_bool_t lia_CALL abiGetData(T*& pData, abi_size_t* pSize = lia_NULLPTR, abi_size_t* pCapacity = lia_NULLPTR) lia_NOEXCEPT lia_OVERRIDE {
+		(void)abiGetSize(pCapacity);
+		if (pSize != lia_NULLPTR) {
+			*pSize = static_cast<abi_size_t>(m_vector.size());
+		}
+		return lia::detail::ContiguousData<!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value>::get(pData, m_vector);
+	}
+
+	virtual abi_bool_t lia_CALL abiGetDataConst(const T*& pData, abi_size_t* pSize = lia_NULLPTR, abi_size_t* pCapacity = lia_NULLPTR) const lia_NOEXCEPT lia_OVERRIDE {
+		(void)abiGetSize(pCapacity);
+		if (pSize != lia_NULLPTR) {
+			*pSize = static_cast<abi_size_t>(m_vector.size());
+		}
+		return lia::detail::ContiguousData<!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value>::get(pData, m_vector);
+	}
+
+	virtual abi_bool_t lia_CALL abiGetRange(abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::Pointer* pElems) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i   = static_cast<std::size_t>(idx);
+		const std::size_t num = static_cast<std::size_t>(n);
+		if ((i > m_vector.size()) || (num > (m_vector.size() - i))) {
+			return abi_false;
+		}
+		for (std::size_t j=0; j<num; ++j) {
+			lia::detail::assignElemPtr(pElems[j], m_vector[i + j]);
+		}
+		return abi_true;
+	}
+
+	virtual abi_bool_t lia_CALL abiGetRangeConst(abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer* pElems) const lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i   = static_cast<std::size_t>(idx);
+		const std::size_t num = static_cast<std::size_t>(n);
+		if ((i > m_vector.size()) || (num > (m_vector.size() - i))) {
+			return abi_false;
+		}
+		for (std::size_t j=0; j<num; ++j) {
+			lia::detail::assignElemPtr(pElems[j], m_vector[i + j]);
+		}
+		return abi_true;
 	}
 
-	virtual abi_ptrdiff_t lia_CALL abiGetDistance(const IVectorIterator<T>& other_) const lia_NOEXCEPT lia_OVERRIDE {
-		const ThisType& other = static_cast<const ThisType&>(other_);
-		return static_cast<abi_ptrdiff_t>(m_iter - other.m_iter);
+	virtual abi_bool_t lia_CALL abiInsertFill(abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i   = static_cast<std::size_t>(idx);
+		const std::size_t num = static_cast<std::size_t>(n);
+		lia_TRY
+			if (i <= m_vector.size()) {
+				m_vector.insert(m_vector.begin() + i, num, lia::detail::derefElemPtr(pElem));
+			}
+			else {
+				return abi_false;
+			}
+		lia_CATCHALL(return abi_false)
+		return abi_true;
 	}
 
-	virtual void lia_CALL abiAdvance(abi_ptrdiff_t n) lia_NOEXCEPT lia_OVERRIDE {
-		m_iter += static_cast<std::ptrdiff_t>(n);
+	virtual abi_bool_t lia_CALL abiReserveAdditional(abi_size_t n, uint32_t growthPercent = kGrowthDefault) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t num      = static_cast<std::size_t>(n);
+		const std::size_t size     = m_vector.size();
+		const std::size_t capacity = m_vector.capacity();
+		if (num > (m_vector.max_size() - size)) {
+			return abi_false;
+		}
+		const std::size_t required = size + num;
+		if (required <= capacity) {
+			return abi_true;
+		}
+		std::size_t newCapacity = required;
+		if (growthPercent > 100u) {
+			const std::size_t maxCapacity = m_vector.max_size();
+			const std::size_t grown = ((capacity / 100u) <= (maxCapacity / growthPercent)) ? ((capacity / 100u) * growthPercent + ((capacity % 100u) * growthPercent) / 100u) : maxCapacity;
+			newCapacity = std::max(required, std::min(grown, maxCapacity));
+		}
+		lia_TRY
+			m_vector.reserve(newCapacity);
+		lia_CATCHALL(return abi_false)
+		return abi_true;
 	}
 
-	virtual void lia_CALL abiDereference(typename lia::detail::MakeTypes<T>::Pointer& pElem, abi_ptrdiff_t i) const lia_NOEXCEPT lia_OVERRIDE {
-		lia::detail::assignElemPtr(pElem, m_iter[static_cast<std::ptrdiff_t>(i)]);
+	virtual abi_bool_t lia_CALL abiResize(abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer* pValue = lia_NULLPTR) lia_NOEXCEPT lia_OVERRIDE {
+		lia_TRY
+			if (pValue != lia_NULLPTR) {
+				m_vector.resize(static_cast<std::size_t>(n), lia::detail::derefElemPtr(*pValue));
+			}
+			else {
+				m_vector.resize(static_cast<std::size_t>(n));
+			}
+		lia_CATCHALL(return abi_false)
+		return abi_true;
 	}
 
-private:
-	TIterator  m_iter;
-};
+	virtual abi_bool_t lia_CALL abiPopBack() lia_NOEXCEPT lia_OVERRIDE {
+		if (m_vector.empty()) {
+			return abi_false;
+		}
+		m_vector.pop_back();
+		return abi_true;
+	}
 
-template<typename T, typename TVector>
-class VectorRef lia_FINAL: public IVector<T> {
-public:
+	virtual abi_bool_t lia_CALL abiSwap(IVector<T>& other) lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::RemoveReference<TVector>::type TStorage;
+		InterfaceVersion v;
+		other.abiGetIVectorVersion(v);
+		if ((v.major != 0) || (v.minor < 13)) {
+			return abi_false;
+		}
+		void* pOther = other.abiGetNativeObject(lia_TOOLCHAIN_ID, lia::detail::TypeId<TStorage>::get());
+		if (pOther == lia_NULLPTR) {
+			return abi_false;
+		}
+		m_vector.swap(*static_cast<TStorage*>(pOther));
+		return abi_true;
+	}
 
-	typedef VectorRef<T, TVector> ThisType;
+	virtual abi_bool_t lia_CALL abiVisit(abi_size_t idx, abi_size_t n, typename lia::detail::VisitTypes<T>::Function pFunc, void* pContext) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i   = static_cast<std::size_t>(idx);
+		const std::size_t num = static_cast<std::size_t>(n);
+		if ((i > m_vector.size()) || (num > (m_vector.size() - i))) {
+			return abi_false;
+		}
+		return lia::detail::VisitRange<!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value>::template visit<typename lia::detail::MakeTypes<T>::Pointer>(pFunc, pContext, m_vector, i, num);
+	}
 
-	VectorRef() lia_NOEXCEPT {}
-	explicit VectorRef(TVector& v) lia_NOEXCEPT :m_vector(v) {}
-	virtual ~VectorRef() lia_NOEXCEPT {}
+	virtual abi_bool_t lia_CALL abiVisitConst(abi_size_t idx, abi_size_t n, typename lia::detail::VisitTypes<T>::ConstFunction pFunc, void* pContext) const lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i   = static_cast<std::size_t>(idx);
+		const std::size_t num = static_cast<std::size_t>(n);
+		if ((i > m_vector.size()) || (num > (m_vector.size() - i))) {
+			return abi_false;
+		}
+		return lia::detail::VisitRange<!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value>::template visit<typename lia::detail::MakeTypes<T>::ConstPointer>(pFunc, pContext, m_vector, i, num);
+	}
 
-	void operator delete(void* p) {
-		::operator delete(p);
+	virtual void lia_CALL abiConstructReverseIterator(abi_bool_t atBegin, void* pBuf) lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::RemoveReference<TVector>::type::reverse_iterator TIterator;
+		typedef typename lia::detail::RemoveReference<TVector>::type::const_reverse_iterator TConstIterator;
+		new (pBuf) VectorIteratorRef<T, TIterator, TConstIterator>(atBegin ? m_vector.rbegin() : m_vector.rend());
 	}
 
-	virtual void lia_CALL abiGetIVectorVersion(InterfaceVersion& v) const lia_NOEXCEPT lia_OVERRIDE {
-		v.major = 0;
-		v.minor = 1;
+	virtual void lia_CALL abiConstructReverseConstIterator(abi_bool_t atBegin, void* pBuf) const lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::RemoveReference<TVector>::type::const_reverse_iterator TConstIterator;
+		new (pBuf) VectorIteratorRef<const T, TConstIterator, TConstIterator>(atBegin ? m_vector.rbegin() : m_vector.rend());
 	}
 
-	virtual void lia_CALL abiDestroy() lia_NOEXCEPT lia_OVERRIDE {
-		delete this;
+	// pNumValues is the capacity of pValues on input and the number of values of all rows on output. With pOffsets
+	// being NULL, only the number of values is returned. pOffsets receives size()+1 entries otherwise.
+	virtual abi_bool_t lia_CALL abiExportFlat(abi_size_t* pOffsets, typename lia::detail::FlatTypes<T>::Value* pValues, abi_size_t* pNumValues) const lia_NOEXCEPT lia_OVERRIDE {
+		return lia::detail::FlatAccess<lia::detail::FlatTypes<T>::isFlattenable>::exportTo(m_vector, pOffsets, pValues, pNumValues);
 	}
 
-	virtual void lia_CALL abiClear() lia_NOEXCEPT lia_OVERRIDE {
-		m_vector.clear();
+	// Replaces the contents by numRows rows, row i consisting of pValues[pOffsets[i]] ... pValues[pOffsets[i+1]-1]
+	virtual abi_bool_t lia_CALL abiImportFlat(const abi_size_t* pOffsets, abi_size_t numRows, const typename lia::detail::FlatTypes<T>::Value* pValues) lia_NOEXCEPT lia_OVERRIDE {
+		return lia::detail::FlatAccess<lia::detail::FlatTypes<T>::isFlattenable>::importFrom(m_vector, pOffsets, numRows, pValues);
 	}
 
-	virtual abi_bool_t lia_CALL abiReserve(abi_size_t n, abi_bool_t shrinkToFit = abi_false) lia_NOEXCEPT lia_OVERRIDE {
-		if (n > 0) {
-			lia_TRY
-				m_vector.reserve(static_cast<std::size_t>(n));
-			lia_CATCHALL(return abi_false)
+	virtual uint32_t lia_CALL abiGetCapabilities(const char* pCallerToolchainId) const lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::RemoveConst<T>::type TNonConst;
+		uint32_t caps = kCapBulkInsert | kCapNativeAlgorithms | kCapThreadSafeReads | lia::detail::getToolchainCapability(pCallerToolchainId);
+		if (!lia::detail::IsLiaInterface<TNonConst>::value) {
+			caps |= kCapContiguousStorage;
 		}
-#if lia_CPP11_API
-		if (shrinkToFit) {
-			lia_TRY
-				m_vector.shrink_to_fit();
-			lia_CATCHALL(return abi_false)
+		if (lia::detail::IsTriviallyRelocatable<TNonConst>::value) {
+			caps |= kCapTriviallyRelocatable;
 		}
-#endif
-		return abi_true;
+		return caps;
 	}
 
-	virtual abi_bool_t lia_CALL abiInsert(abi_size_t idx, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) lia_NOEXCEPT lia_OVERRIDE {
+	virtual void* lia_CALL abiGetNativeObject(const char* pCallerToolchainId, const char* pNativeTypeId) const lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::RemoveReference<TVector>::type TStorage;
+		if (!lia::detail::isNativeTypeOfCaller<TStorage>(pCallerToolchainId, pNativeTypeId)) {
+			return lia_NULLPTR;
+		}
+		return const_cast<TStorage*>(&m_vector);
+	}
+
+	virtual abi_bool_t lia_CALL abiInsertMove(abi_size_t idx, typename lia::detail::MakeTypes<T>::Pointer& pElem) lia_NOEXCEPT lia_OVERRIDE {
 		const std::size_t i = static_cast<std::size_t>(idx);
 		lia_TRY
 			if (i <= m_vector.size()) {
-				m_vector.insert(m_vector.begin() + i, lia::detail::derefElemPtr(pElem));
+				lia::detail::MoveElement<lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value>::insert(m_vector, i, pElem);
 			}
 			else {
 				return abi_false;
@@ -561,55 +1761,227 @@ public:
 		return abi_true;
 	}
 
-	virtual abi_bool_t lia_CALL abiRemove(abi_size_t idx, abi_size_t n = 1u) lia_NOEXCEPT lia_OVERRIDE {
+	// Sorts inside this module, calling back into the caller's module only for comparisons with pLess.
+	// middle is the end of the sorted range for kSortPartial, and the index of the nth element for kSortNthElement.
+	virtual abi_bool_t lia_CALL abiSort(uint32_t algorithm, abi_size_t middle, typename lia::detail::CompareTypes<T>::Function pLess, void* pContext, uint32_t numThreads) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t m = static_cast<std::size_t>(middle);
+		if ((algorithm > kSortNthElement) || (m > m_vector.size())) {
+			return abi_false;
+		}
+		lia_TRY
+			if (pLess == lia_NULLPTR) {
+				return sortByOperator(algorithm, m, static_cast<std::size_t>(numThreads), lia::detail::BoolType<lia::detail::HasLess<Element>::value>());
+			}
+			else {
+				lia::detail::runSortAlgorithm(m_vector.begin(), m_vector.end(), algorithm, m, lia::detail::CallbackCompare<T>(pLess, pContext), static_cast<std::size_t>(numThreads));
+			}
+		lia_CATCHALL(return abi_false)
+		return abi_true;
+	}
+
+	// Searches the elements [idx, idx+n). *pResult is an index into the whole vector for kSearchFind, which is idx+n
+	// if no element matches, and the number of matching elements for kSearchCount.
+	virtual abi_bool_t lia_CALL abiFind(uint32_t algorithm, abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer& pValue, typename lia::detail::PredicateTypes<T>::Function pPred, void* pContext, abi_size_t* pResult) const lia_NOEXCEPT lia_OVERRIDE {
 		const std::size_t i   = static_cast<std::size_t>(idx);
 		const std::size_t num = static_cast<std::size_t>(n);
-		if (i >= m_vector.size()) {
+		if ((algorithm > kSearchCount) || (i > m_vector.size()) || (num > (m_vector.size() - i)) || (pResult == lia_NULLPTR)) {
 			return abi_false;
 		}
 		lia_TRY
-				m_vector.erase(m_vector.begin() + i, m_vector.begin() + i + num);
+			if (pPred == lia_NULLPTR) {
+				return findByOperator(i, i + num, algorithm, pValue, pResult, lia::detail::BoolType<lia::detail::HasEqual<Element>::value>());
+			}
+			else {
+				*pResult = static_cast<abi_size_t>(lia::detail::scanIndices(i, i + num, algorithm, lia::detail::elementAt<T>(m_vector, lia::detail::CallbackPredicate<T>(pPred, pContext))));
+			}
 		lia_CATCHALL(return abi_false)
 		return abi_true;
 	}
 
-	virtual abi_size_t lia_CALL abiGetSize(abi_size_t* pCapacity = lia_NULLPTR) const lia_NOEXCEPT lia_OVERRIDE {
-		if (pCapacity != lia_NULLPTR) {
-			*pCapacity = static_cast<abi_size_t>(m_vector.capacity());
+	// Searches the sorted elements [idx, idx+n) for *pValue. pResult receives two indices for kSearchEqualRange, one otherwise.
+	virtual abi_bool_t lia_CALL abiBinarySearch(uint32_t algorithm, abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer& pValue, typename lia::detail::CompareTypes<T>::Function pLess, void* pContext, abi_size_t* pResult) const lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i   = static_cast<std::size_t>(idx);
+		const std::size_t num = static_cast<std::size_t>(n);
+		if ((algorithm < kSearchLowerBound) || (algorithm > kSearchEqualRange) || (i > m_vector.size()) || (num > (m_vector.size() - i)) || (pResult == lia_NULLPTR)) {
+			return abi_false;
 		}
-		return static_cast<abi_size_t>(m_vector.size());
+		lia_TRY
+			if (pLess == lia_NULLPTR) {
+				return searchBoundsByOperator(i, i + num, algorithm, pValue, pResult, lia::detail::BoolType<lia::detail::HasLess<Element>::value>());
+			}
+			else {
+				searchBounds(i, i + num, algorithm, pValue, lia::detail::CallbackPointerCompare<T>(pLess, pContext), pResult);
+			}
+		lia_CATCHALL(return abi_false)
+		return abi_true;
 	}
 
-	virtual abi_bool_t lia_CALL abiGetAt(abi_size_t idx, typename lia::detail::MakeTypes<T>::Pointer& pElem) lia_NOEXCEPT lia_OVERRIDE {
-		const std::size_t i = static_cast<std::size_t>(idx);
-		if (i < m_vector.size()) {
-			lia::detail::assignElemPtr(pElem, m_vector[i]);
-			return abi_true;
+	// Reduces the elements [idx, idx+n), and for kReduceDot the same elements of *pOther, with the SIMD kernels for the
+	// CPU this module runs on. pResult points to the type documented for the operation, indices are into the whole vector.
+	virtual abi_bool_t lia_CALL abiReduce(uint32_t operation, abi_size_t idx, abi_size_t n, const IVector<T>* pOther, void* pResult) const lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::RemoveConst<T>::type TNonConst;
+		const std::size_t i   = static_cast<std::size_t>(idx);
+		const std::size_t num = static_cast<std::size_t>(n);
+		if ((i > m_vector.size()) || (num > (m_vector.size() - i)) || (pResult == lia_NULLPTR)) {
+			return abi_false;
 		}
-		return abi_false;
+		const T* pOtherData = lia_NULLPTR;
+		if (operation == kReduceDot) {
+			if (pOther == lia_NULLPTR) {
+				return abi_false;
+			}
+			InterfaceVersion v;
+			pOther->abiGetIVectorVersion(v);
+			abi_size_t otherSize = 0;
+			if ((v.major != 0) || (v.minor < 3) || !pOther->abiGetDataConst(pOtherData, &otherSize) || (static_cast<std::size_t>(otherSize) < (i + num))) {
+				return abi_false; // the caller falls back to copying the elements of *pOther
+			}
+			pOtherData += i;
+		}
+		if (!lia::detail::ReduceRange<lia::detail::ReduceTypes<TNonConst>::isAbiFixed>::reduceAt(m_vector, i, num, operation, pOtherData, pResult)) {
+			return abi_false;
+		}
+		if ((operation == kReduceArgMin) || (operation == kReduceArgMax)) {
+			*static_cast<abi_size_t*>(pResult) += idx;
+		}
+		return abi_true;
 	}
 
-	virtual abi_bool_t lia_CALL abiGetAtConst(abi_size_t idx, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) const lia_NOEXCEPT lia_OVERRIDE {
-		const std::size_t i = static_cast<std::size_t>(idx);
-		if (i < m_vector.size()) {
-			lia::detail::assignElemPtr(pElem, m_vector[i]);
-			return abi_true;
+	virtual abi_bool_t lia_CALL abiHistogram(abi_size_t idx, abi_size_t n, double lower, double upper, abi_size_t numBins, abi_size_t* pCounts) const lia_NOEXCEPT lia_OVERRIDE {
+		typedef typename lia::detail::RemoveConst<T>::type TNonConst;
+		const std::size_t i   = static_cast<std::size_t>(idx);
+		const std::size_t num = static_cast<std::size_t>(n);
+		if ((i > m_vector.size()) || (num > (m_vector.size() - i))) {
+			return abi_false;
 		}
-		return abi_false;
+		return lia::detail::ReduceRange<lia::detail::ReduceTypes<TNonConst>::isReducible>::histogramAt(m_vector, i, num, lower, upper, static_cast<std::size_t>(numBins), pCounts) ? abi_true : abi_false;
 	}
 
-	virtual void lia_CALL abiConstructIterator(abi_bool_t atBegin, void* pBuf) lia_NOEXCEPT lia_OVERRIDE {
-		typedef typename lia::detail::RemoveReference<TVector>::type::iterator TIterator;
-		typedef typename lia::detail::RemoveReference<TVector>::type::const_iterator TConstIterator;
-		new (pBuf) VectorIteratorRef<T, TIterator, TConstIterator>(atBegin ? m_vector.begin() : m_vector.end());
+	// The following remove elements of [idx, idx+n) in one pass, moving each remaining element at most once. pNumRemoved
+	// may be NULL. If a callback aborts, the elements are left in a valid but unspecified state.
+	virtual abi_bool_t lia_CALL abiRemoveIf(abi_size_t idx, abi_size_t n, typename lia::detail::PredicateTypes<T>::Function pPred, void* pContext, abi_size_t* pNumRemoved) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i   = static_cast<std::size_t>(idx);
+		const std::size_t num = static_cast<std::size_t>(n);
+		if ((i > m_vector.size()) || (num > (m_vector.size() - i)) || (pPred == lia_NULLPTR)) {
+			return abi_false;
+		}
+		lia_TRY
+			const std::size_t newEnd = lia::detail::compactIndices(m_vector, i, i + num, lia::detail::elementAt<T>(m_vector, lia::detail::CallbackPredicate<T>(pPred, pContext)));
+			eraseTail(newEnd, i + num, pNumRemoved);
+		lia_CATCHALL(return abi_false)
+		return abi_true;
 	}
 
-	virtual void lia_CALL abiConstructConstIterator(abi_bool_t atBegin, void* pBuf) const lia_NOEXCEPT lia_OVERRIDE {
-		typedef typename lia::detail::RemoveReference<TVector>::type::const_iterator TConstIterator;
-		new (pBuf) VectorIteratorRef<const T, TConstIterator, TConstIterator>(atBegin ? m_vector.begin() : m_vector.end());
+	virtual abi_bool_t lia_CALL abiUnique(abi_size_t idx, abi_size_t n, typename lia::detail::CompareTypes<T>::Function pEqual, void* pContext, abi_size_t* pNumRemoved) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t i   = static_cast<std::size_t>(idx);
+		const std::size_t num = static_cast<std::size_t>(n);
+		if ((i > m_vector.size()) || (num > (m_vector.size() - i))) {
+			return abi_false;
+		}
+		lia_TRY
+			if (pEqual == lia_NULLPTR) {
+				return uniqueByOperator(i, i + num, pNumRemoved, lia::detail::BoolType<lia::detail::HasEqual<Element>::value>());
+			}
+			else {
+				eraseTail(static_cast<std::size_t>(std::unique(m_vector.begin() + i, m_vector.begin() + (i + num), lia::detail::CallbackCompare<T>(pEqual, pContext)) - m_vector.begin()), i + num, pNumRemoved);
+			}
+		lia_CATCHALL(return abi_false)
+		return abi_true;
+	}
+
+	virtual abi_bool_t lia_CALL abiKeepMasked(const uint8_t* pMask, abi_size_t maskSize, uint32_t maskFormat, abi_size_t* pNumRemoved) lia_NOEXCEPT lia_OVERRIDE {
+		if ((maskFormat > kMaskBits) || ((pMask == lia_NULLPTR) && !m_vector.empty()) || !lia::detail::coversElements(static_cast<std::size_t>(maskSize), maskFormat, m_vector.size())) {
+			return abi_false;
+		}
+		lia_TRY
+			eraseTail(lia::detail::compactIndices(m_vector, 0u, m_vector.size(), lia::detail::MaskedOut(pMask, maskFormat)), m_vector.size(), pNumRemoved);
+		lia_CATCHALL(return abi_false)
+		return abi_true;
+	}
+
+	// The following access the elements at n arbitrary indices in one call. All indices are checked before any element is
+	// accessed. If an index occurs more than once in abiScatter(), the last of its elements is assigned.
+	virtual abi_bool_t lia_CALL abiGatherConst(const abi_size_t* pIndices, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer* pElems) const lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t num = static_cast<std::size_t>(n);
+		if ((num > 0u) && ((pIndices == lia_NULLPTR) || (pElems == lia_NULLPTR) || !lia::detail::areValidIndices(pIndices, num, m_vector.size()))) {
+			return abi_false;
+		}
+		for (std::size_t j=0; j<num; ++j) {
+			lia::detail::assignElemPtr(pElems[j], m_vector[static_cast<std::size_t>(pIndices[j])]);
+		}
+		return abi_true;
+	}
+
+	virtual abi_bool_t lia_CALL abiScatter(const abi_size_t* pIndices, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer* pElems) lia_NOEXCEPT lia_OVERRIDE {
+		const std::size_t num = static_cast<std::size_t>(n);
+		if ((num > 0u) && ((pIndices == lia_NULLPTR) || (pElems == lia_NULLPTR) || !lia::detail::areValidIndices(pIndices, num, m_vector.size()))) {
+			return abi_false;
+		}
+		lia_TRY
+			for (std::size_t j=0; j<num; ++j) {
+				m_vector[static_cast<std::size_t>(pIndices[j])] = lia::detail::derefElemPtr(pElems[j]);
+			}
+		lia_CATCHALL(return abi_false)
+		return abi_true;
 	}
 
 private:
+
+	typedef typename lia::detail::RemoveReference<TVector>::type::value_type Element;
+
+	// The algorithms that are called without a callback use operator== or operator< of the elements. For element types
+	// without them, they report failure instead of breaking the compilation of every VectorRef of these types.
+	abi_bool_t sortByOperator(uint32_t algorithm, std::size_t middle, std::size_t numThreads, lia::detail::BoolType<true>) {
+		lia::detail::runSortAlgorithm(m_vector.begin(), m_vector.end(), algorithm, middle, lia::detail::DefaultLess(), numThreads);
+		return abi_true;
+	}
+
+	abi_bool_t sortByOperator(uint32_t, std::size_t, std::size_t, lia::detail::BoolType<false>) lia_NOEXCEPT {
+		return abi_false;
+	}
+
+	abi_bool_t findByOperator(std::size_t first, std::size_t last, uint32_t algorithm, typename lia::detail::MakeTypes<T>::ConstPointer& pValue, abi_size_t* pResult, lia::detail::BoolType<true>) const {
+		*pResult = static_cast<abi_size_t>(lia::detail::ScanForValue<!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value>::template scan<T>(m_vector, first, last, algorithm, pValue));
+		return abi_true;
+	}
+
+	abi_bool_t findByOperator(std::size_t, std::size_t, uint32_t, typename lia::detail::MakeTypes<T>::ConstPointer&, abi_size_t*, lia::detail::BoolType<false>) const lia_NOEXCEPT {
+		return abi_false;
+	}
+
+	abi_bool_t searchBoundsByOperator(std::size_t first, std::size_t last, uint32_t algorithm, typename lia::detail::MakeTypes<T>::ConstPointer& pValue, abi_size_t* pResult, lia::detail::BoolType<true>) const {
+		searchBounds(first, last, algorithm, pValue, lia::detail::PointerLess<T>(), pResult);
+		return abi_true;
+	}
+
+	abi_bool_t searchBoundsByOperator(std::size_t, std::size_t, uint32_t, typename lia::detail::MakeTypes<T>::ConstPointer&, abi_size_t*, lia::detail::BoolType<false>) const lia_NOEXCEPT {
+		return abi_false;
+	}
+
+	abi_bool_t uniqueByOperator(std::size_t first, std::size_t last, abi_size_t* pNumRemoved, lia::detail::BoolType<true>) {
+		eraseTail(static_cast<std::size_t>(std::unique(m_vector.begin() + first, m_vector.begin() + last) - m_vector.begin()), last, pNumRemoved);
+		return abi_true;
+	}
+
+	abi_bool_t uniqueByOperator(std::size_t, std::size_t, abi_size_t*, lia::detail::BoolType<false>) lia_NOEXCEPT {
+		return abi_false;
+	}
+
+	// Erases the elements [newEnd, end) that were left over by compacting the elements before end
+	void eraseTail(std::size_t newEnd, std::size_t end, abi_size_t* pNumRemoved) {
+		m_vector.erase(m_vector.begin() + newEnd, m_vector.begin() + end);
+		if (pNumRemoved != lia_NULLPTR) {
+			*pNumRemoved = static_cast<abi_size_t>(end - newEnd);
+		}
+	}
+
+	template<typename TLess>
+	void searchBounds(std::size_t first, std::size_t last, uint32_t algorithm, typename lia::detail::MakeTypes<T>::ConstPointer& pValue, TLess less, abi_size_t* pResult) const {
+		lia::detail::searchBounds(first, last, algorithm,
+			lia::detail::elementAt<T>(m_vector, lia::detail::IsBeforeValue<T, TLess>(pValue, less)),
+			lia::detail::elementAt<T>(m_vector, lia::detail::IsNotAfterValue<T, TLess>(pValue, less)), pResult);
+	}
+
 	TVector m_vector; // either a reference or a type
 };
 
@@ -634,6 +2006,39 @@ typename MakeRef< std::vector<A, B> >::Type makeRef(std::vector<A, B>& v) {
 
 }
 
+#if lia_CPP11_API
+
+namespace std {
+
+// Hashes the elements, so that vectors can be keys of unordered containers, see VectorApiMixin::hashValue()
+template<typename T>
+struct hash< lia::IVector<T> > {
+	std::size_t operator()(const lia::IVector<T>& v) const {
+		return v.hashValue();
+	}
+};
+
+}
+
+#endif
+
+#if lia_CPP20_API
+
+// A VectorView doesn't own the elements, so it is a view, and its iterators stay valid when the view is destroyed
+namespace std {
+namespace ranges {
+
+template<typename T>
+inline constexpr bool enable_view< lia::VectorView<T> > = true;
+
+template<typename T>
+inline constexpr bool enable_borrowed_range< lia::VectorView<T> > = true;
+
+}
+}
+
+#endif
+
 #else /* C compiler */
 
 /* Not yet implemented */
@@ -0,0 +1,381 @@
+/*
++-----------------------------------+
+|                                   |
+|                 A                 |
+|                A A                |
+|               A   A               |
+|              A     A              |
+|  #  AAAAAAAAAAAAAAAAAAAAAAAAA  #  |
+|  ###       A         A       ###  |
+|  ######   A           A    #####  |
+|  ####### A             A #######  |
+|                                   |
++-----------------------------------+
+
+L I B A C R O S S - Using C++ containers
+ across DLL- and ABI-stable boundaries
+
+If you like this project, please refer to it with a link or
+some other reference. You can use this ASCII art icon as well
+as the supplied graphical icons for that purpose.
+
+(c) Copyright 2019 Jens Ganter-Benzing
+
+Licensed under the MIT license:
+
+http://www.opensource.org/licenses/mit-license.php
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#ifndef lia_Parallel_h_INCLUDED
+#define lia_Parallel_h_INCLUDED
+
+#include <lia/IVector.h>
+#if defined(__cplusplus) && lia_CPP11_API
+	#include <algorithm>
+	#include <atomic>
+	#include <thread>
+	#include <vector>
+#endif
+#include <lia/detail/PushWarnings.h>
+
+#if defined(__cplusplus) && lia_CPP11_API
+
+namespace lia {
+namespace parallel {
+
+const std::size_t kDefaultGrainSize = 65536u;
+
+//! How the algorithms of lia::parallel split a vector into index ranges. The ranges have grainSize elements each
+//! (the last one may be shorter) and are processed on up to numThreads threads, with numThreads being 0 meaning one
+//! thread per hardware thread. isDeterministic only affects reduce().
+struct Policy {
+	std::size_t numThreads;
+	std::size_t grainSize;
+	bool        isDeterministic;
+
+	explicit Policy(std::size_t threads = 0u, std::size_t grain = kDefaultGrainSize, bool deterministic = false) lia_NOEXCEPT:
+		numThreads(threads), grainSize(grain), isDeterministic(deterministic) {}
+};
+
+}
+
+namespace detail {
+
+template<typename T>
+uint32_t getIVectorMinorVersion(const IVector<T>& v) lia_NOEXCEPT {
+	InterfaceVersion version;
+	v.abiGetIVectorVersion(version);
+	return (version.major == 0) ? version.minor : 0u;
+}
+
+// Read access to the elements of a vector from worker threads. Elements of types other than lia interfaces are read
+// directly in the storage of the vector if the implementation provides it, others are fetched in chunks of pointers.
+template<typename T>
+class ConstElementAccess {
+public:
+
+	typedef typename MakeTypes<T>::ConstPointer Pointer;
+	typedef const T*                            DataPointer;
+
+	explicit ConstElementAccess(const IVector<T>& v) lia_NOEXCEPT: m_vector(v), m_pData(lia_NULLPTR), m_minor(getIVectorMinorVersion(v)) {
+		if ((m_minor < 3) || IsLiaInterface<typename RemoveConst<T>::type>::value || !m_vector.abiGetDataConst(m_pData)) {
+			m_pData = lia_NULLPTR;
+		}
+	}
+
+	DataPointer data() const lia_NOEXCEPT {
+		return m_pData;
+	}
+
+	// Fetches pointers to the n <= kChunkSize elements at idx with one call, or one per element for implementations
+	// before IVector version 0.4
+	void fetch(std::size_t idx, std::size_t n, Pointer* pElems) const {
+		if (m_minor >= 4) {
+			if (!m_vector.abiGetRangeConst(static_cast<abi_size_t>(idx), static_cast<abi_size_t>(n), pElems)) {
+				lia_THROW1(std::out_of_range, "in lia::parallel call");
+			}
+			return;
+		}
+		for (std::size_t j=0; j<n; ++j) {
+			if (!m_vector.abiGetAtConst(static_cast<abi_size_t>(idx + j), pElems[j])) {
+				lia_THROW1(std::out_of_range, "in lia::parallel call");
+			}
+		}
+	}
+
+private:
+	const IVector<T>& m_vector;
+	const T*          m_pData;
+	uint32_t          m_minor;
+};
+
+// Write access like ConstElementAccess. Worker threads only access distinct elements, which implementations must
+// allow like std::vector does.
+template<typename T>
+class ElementAccess {
+public:
+
+	typedef typename MakeTypes<T>::Pointer Pointer;
+	typedef T*                             DataPointer;
+
+	explicit ElementAccess(IVector<T>& v) lia_NOEXCEPT: m_vector(v), m_pData(lia_NULLPTR), m_minor(getIVectorMinorVersion(v)) {
+		if ((m_minor < 3) || IsLiaInterface<typename RemoveConst<T>::type>::value || !m_vector.abiGetData(m_pData)) {
+			m_pData = lia_NULLPTR;
+		}
+	}
+
+	DataPointer data() const lia_NOEXCEPT {
+		return m_pData;
+	}
+
+	void fetch(std::size_t idx, std::size_t n, Pointer* pElems) const {
+		if (m_minor >= 4) {
+			if (!m_vector.abiGetRange(static_cast<abi_size_t>(idx), static_cast<abi_size_t>(n), pElems)) {
+				lia_THROW1(std::out_of_range, "in lia::parallel call");
+			}
+			return;
+		}
+		for (std::size_t j=0; j<n; ++j) {
+			if (!m_vector.abiGetAt(static_cast<abi_size_t>(idx + j), pElems[j])) {
+				lia_THROW1(std::out_of_range, "in lia::parallel call");
+			}
+		}
+	}
+
+private:
+	IVector<T>& m_vector;
+	T*          m_pData;
+	uint32_t    m_minor;
+};
+
+inline std::size_t countRanges(std::size_t n, const lia::parallel::Policy& policy) lia_NOEXCEPT {
+	const std::size_t grainSize = std::max(policy.grainSize, static_cast<std::size_t>(1u));
+	return (n / grainSize) + (((n % grainSize) != 0u) ? 1u : 0u);
+}
+
+inline std::size_t countThreads(std::size_t n, const lia::parallel::Policy& policy) lia_NOEXCEPT {
+	std::size_t numThreads = policy.numThreads;
+	if (numThreads == 0u) {
+		numThreads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+	}
+	return std::max(std::min(numThreads, countRanges(n, policy)), static_cast<std::size_t>(1u));
+}
+
+// Calls func(range, first, last, thread) for the ranges of [0, n) on countThreads() threads, with the calling thread
+// being thread 0. Each thread takes the next unprocessed range whenever it's done with one, which balances uneven
+// costs per element. After an exception, the remaining ranges are skipped and the exception is rethrown.
+template<typename TFunc>
+void forEachRange(std::size_t n, const lia::parallel::Policy& policy, TFunc func) {
+	const std::size_t numRanges = countRanges(n, policy);
+	const std::size_t grainSize = std::max(policy.grainSize, static_cast<std::size_t>(1u));
+	if (numRanges == 0u) {
+		return;
+	}
+	std::atomic<std::size_t> next(0u);
+	runInParallel(countThreads(n, policy), [&](std::size_t thread) {
+		lia_TRY
+			for (std::size_t range = next++; range < numRanges; range = next++) {
+				const std::size_t first = range * grainSize;
+				func(range, first, std::min(n, first + grainSize), thread);
+			}
+		lia_CATCHALL(next = numRanges; throw)
+	});
+}
+
+// Calls func(elem) for the elements [first, last), in the storage of the vector if possible
+template<typename TAccess, typename TFunc>
+void visitRange(const TAccess& access, std::size_t first, std::size_t last, TFunc& func, BoolType<true>) {
+	const typename TAccess::DataPointer pData = access.data();
+	if (pData == lia_NULLPTR) {
+		visitRange(access, first, last, func, BoolType<false>());
+		return;
+	}
+	for (std::size_t i=first; i<last; ++i) {
+		func(pData[i]);
+	}
+}
+
+template<typename TAccess, typename TFunc>
+void visitRange(const TAccess& access, std::size_t first, std::size_t last, TFunc& func, BoolType<false>) {
+	typename TAccess::Pointer chunk[kChunkSize];
+	for (std::size_t i=first; i<last; i += kChunkSize) {
+		const std::size_t n = std::min(kChunkSize, last - i);
+		access.fetch(i, n, chunk);
+		for (std::size_t j=0; j<n; ++j) {
+			func(derefElemPtr(chunk[j]));
+		}
+	}
+}
+
+// Assigns op(elem) for the elements [first, last) of src to the elements of dst at the same indices
+template<typename TSrc, typename TDst, typename TOp>
+void transformRange(const TSrc& src, const TDst& dst, std::size_t first, std::size_t last, TOp& op, BoolType<true>) {
+	const typename TSrc::DataPointer pSrc = src.data();
+	const typename TDst::DataPointer pDst = dst.data();
+	if ((pSrc == lia_NULLPTR) || (pDst == lia_NULLPTR)) {
+		transformRange(src, dst, first, last, op, BoolType<false>());
+		return;
+	}
+	for (std::size_t i=first; i<last; ++i) {
+		pDst[i] = op(pSrc[i]);
+	}
+}
+
+template<typename TSrc, typename TDst, typename TOp>
+void transformRange(const TSrc& src, const TDst& dst, std::size_t first, std::size_t last, TOp& op, BoolType<false>) {
+	typename TSrc::Pointer srcChunk[kChunkSize];
+	typename TDst::Pointer dstChunk[kChunkSize];
+	for (std::size_t i=first; i<last; i += kChunkSize) {
+		const std::size_t n = std::min(kChunkSize, last - i);
+		src.fetch(i, n, srcChunk);
+		dst.fetch(i, n, dstChunk);
+		for (std::size_t j=0; j<n; ++j) {
+			derefElemPtr(dstChunk[j]) = op(derefElemPtr(srcChunk[j]));
+		}
+	}
+}
+
+// Accumulates the elements of one range, starting with the identity of the operation
+template<typename TResult, typename TOp>
+class PartialReduction {
+public:
+
+	PartialReduction(const TResult& identity, TOp& op): m_value(identity), m_op(op) {}
+
+	template<typename U>
+	void operator()(const U& elem) {
+		m_value = m_op(m_value, elem);
+	}
+
+	const TResult& value() const lia_NOEXCEPT {
+		return m_value;
+	}
+
+private:
+	TResult m_value;
+	TOp&    m_op;
+};
+
+const std::size_t kCacheLineSize = 64u;
+
+// The result of one range or thread of reduce(). The padding keeps the results that different threads write to out of
+// each other's cache lines without over-aligned allocations, which need C++17. It also avoids std::vector<bool>, whose
+// elements share bytes.
+template<typename TResult>
+struct ReductionSlot {
+	explicit ReductionSlot(const TResult& identity): value(identity) {}
+
+	TResult       value;
+	unsigned char padding[kCacheLineSize];
+};
+
+// The operation of copy(). Proxies to const vectors in vectors of vectors can't be assigned to the proxies of the
+// destination, so these are copied through std::vectors.
+struct CopyElement {
+	template<typename U>
+	const U& operator()(const U& u) const lia_NOEXCEPT {
+		return u;
+	}
+
+	template<typename U>
+	std::vector<typename RemoveConst<U>::type> operator()(const VectorProxy<const U>& u) const {
+		return u;
+	}
+};
+
+}
+
+namespace parallel {
+
+//! Calls func(elem) for all elements of v. func is called from several threads at the same time, for different elements.
+//! Elements of types other than lia interfaces are accessed directly in the storage of the vector if possible, others are
+//! fetched in chunks over the ABI boundary. For vectors of vectors, func receives proxies by value, so it should take
+//! its parameter by value or as auto&&.
+template<typename T, typename TFunc>
+void for_each(IVector<T>& v, TFunc func, const Policy& policy = Policy()) {
+	const lia::detail::ElementAccess<T> access(v);
+	lia::detail::forEachRange(static_cast<std::size_t>(v.abiGetSize()), policy, [&](std::size_t, std::size_t first, std::size_t last, std::size_t) {
+		lia::detail::visitRange(access, first, last, func, lia::detail::BoolType<!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value>());
+	});
+}
+
+template<typename T, typename TFunc>
+void for_each(const IVector<T>& v, TFunc func, const Policy& policy = Policy()) {
+	const lia::detail::ConstElementAccess<T> access(v);
+	lia::detail::forEachRange(static_cast<std::size_t>(v.abiGetSize()), policy, [&](std::size_t, std::size_t first, std::size_t last, std::size_t) {
+		lia::detail::visitRange(access, first, last, func, lia::detail::BoolType<!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value>());
+	});
+}
+
+//! Resizes out to the size of in and assigns op(elem) for each element of in to the element of out at the same index.
+//! op is called from several threads at the same time like the function of for_each().
+template<typename T, typename U, typename TOp>
+void transform(const IVector<T>& in, IVector<U>& out, TOp op, const Policy& policy = Policy()) {
+	const std::size_t n = static_cast<std::size_t>(in.abiGetSize());
+	out.resize(n);
+	const lia::detail::ConstElementAccess<T> src(in);
+	const lia::detail::ElementAccess<U> dst(out);
+	lia::detail::forEachRange(n, policy, [&](std::size_t, std::size_t first, std::size_t last, std::size_t) {
+		lia::detail::transformRange(src, dst, first, last, op, lia::detail::BoolType<
+			!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value &&
+			!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<U>::type>::value>());
+	});
+}
+
+//! Resizes out to the size of in and copies the elements of in to it
+template<typename T, typename U>
+void copy(const IVector<T>& in, IVector<U>& out, const Policy& policy = Policy()) {
+	transform(in, out, lia::detail::CopyElement(), policy);
+}
+
+//! Reduces the elements of v with op. Each range is reduced on its own, starting with identity, by op(result, elem),
+//! and the results of the ranges are combined by op(result, rangeResult), so identity must be neutral for op (like 0
+//! for addition) and op must be associative. Without policy.isDeterministic, each thread combines the results of the
+//! ranges it happened to take, so the order of the combinations depends on the scheduling and op must be commutative as
+//! well. With it, the results of the ranges are combined in index order, which only depends on policy.grainSize, so that
+//! floating point results are the same for any number of threads.
+template<typename T, typename TResult, typename TOp>
+TResult reduce(const IVector<T>& v, TResult identity, TOp op, const Policy& policy = Policy()) {
+	const std::size_t n = static_cast<std::size_t>(v.abiGetSize());
+	const lia::detail::ConstElementAccess<T> access(v);
+	const std::size_t numSlots = policy.isDeterministic ? lia::detail::countRanges(n, policy) : lia::detail::countThreads(n, policy);
+	std::vector< lia::detail::ReductionSlot<TResult> > results(numSlots, lia::detail::ReductionSlot<TResult>(identity));
+	lia::detail::forEachRange(n, policy, [&](std::size_t range, std::size_t first, std::size_t last, std::size_t thread) {
+		lia::detail::PartialReduction<TResult, TOp> partial(identity, op);
+		lia::detail::visitRange(access, first, last, partial, lia::detail::BoolType<!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value>());
+		TResult& rResult = results[policy.isDeterministic ? range : thread].value;
+		rResult = op(rResult, partial.value());
+	});
+	TResult result = identity;
+	for (std::size_t i=0; i<numSlots; ++i) {
+		result = op(result, results[i].value);
+	}
+	return result;
+}
+
+}
+
+}
+
+#endif
+
+#include <lia/detail/PopWarnings.h>
+
+#endif
@@ -82,6 +82,11 @@ THE SOFTWARE.
 		#else
 			#define lia_CPP17_API 0
 		#endif
+		#if (defined(_MSVC_LANG) && (_MSVC_LANG >= 202002L)) /* VS 2019 16.11 with /std:c++20 */
+			#define lia_CPP20_API 1
+		#else
+			#define lia_CPP20_API 0
+		#endif
 	#endif
 #elif defined(__GNUC__) /* GCC */
 	#if defined (_WIN32) /* defined for 32 and 64 bit Windows */
@@ -107,6 +112,11 @@ THE SOFTWARE.
 		#else
 			#define lia_CPP17_API 0
 		#endif
+		#if (__cplusplus >= 202002L)
+			#define lia_CPP20_API 1
+		#else
+			#define lia_CPP20_API 0
+		#endif
 	#endif
 	#if (defined(__LP64__) || defined(_LP64))
 		#define lia_WORD_WIDTH 64
@@ -126,6 +136,7 @@ THE SOFTWARE.
 #ifdef __cplusplus
 
 #include <cstddef> // for std::size_t
+#include <cstring> // for std::strcmp
 #include <cwchar>  // for WCHAR_MIN and WCHAR_MAX
 
 #define lia_EXTERN_C extern "C"
@@ -258,6 +269,7 @@ namespace detail {
 const std::size_t kProxySize       = sizeof(void*)*4u;
 const std::size_t kSharedPtrSize   = sizeof(void*)*4u;
 const std::size_t kIteratorBufSize = sizeof(void*)*10u;
+const std::size_t kChunkSize       = 64u; // number of elements that are passed at once in bulk calls over the ABI boundary
 
 template<typename T>
 T& derefElemPtr(T* ptr) {
@@ -331,6 +343,129 @@ struct InterfaceVersion {
 	uint32_t minor; //!< Is incremented when a new function is appended to the interface
 };
 
+//! Growth factor hints (in percent of the current capacity) used when reserving additional capacity in containers
+const uint32_t kGrowthExact   = 0u;   //!< Reserve exactly the required capacity
+const uint32_t kGrowthDefault = 200u; //!< Double the capacity when growing, like most std::vector implementations do
+
+//! Algorithms that sort the elements of a container inside the module that owns it
+const uint32_t kSortUnstable   = 0u; //!< Like std::sort
+const uint32_t kSortStable     = 1u; //!< Like std::stable_sort
+const uint32_t kSortPartial    = 2u; //!< Like std::partial_sort, sorting the elements before the middle index
+const uint32_t kSortNthElement = 3u; //!< Like std::nth_element, with the middle index being the nth element
+
+//! Algorithms that search the elements of a container inside the module that owns it
+const uint32_t kSearchFind       = 0u; //!< Index of the first matching element, like std::find
+const uint32_t kSearchCount      = 1u; //!< Number of matching elements, like std::count
+const uint32_t kSearchLowerBound = 2u; //!< Like std::lower_bound on a sorted range
+const uint32_t kSearchUpperBound = 3u; //!< Like std::upper_bound on a sorted range
+const uint32_t kSearchEqualRange = 4u; //!< Like std::equal_range on a sorted range, with two result indices
+
+//! Reductions over the elements of a container of arithmetic type inside the module that owns it
+const uint32_t kReduceSum    = 0u; //!< Sum of the elements, as ReduceTypes<T>::Sum
+const uint32_t kReduceMin    = 1u; //!< Smallest element
+const uint32_t kReduceMax    = 2u; //!< Greatest element
+const uint32_t kReduceArgMin = 3u; //!< Index of the first smallest element
+const uint32_t kReduceArgMax = 4u; //!< Index of the first greatest element
+const uint32_t kReduceDot    = 5u; //!< Sum of the products of the elements of two containers, as ReduceTypes<T>::Sum
+
+//! Formats of masks that select elements of a container
+const uint32_t kMaskBytes = 0u; //!< One byte per element, which is selected if the byte isn't zero
+const uint32_t kMaskBits  = 1u; //!< One bit per element, element i being selected by bit i%8 of byte i/8
+
+//! Capability flags of the implementation of a lia interface, as returned by the abiGetCapabilities() functions of the
+//! interfaces. Callers choose faster paths for the flags that are set, and use the basic functions of the interface otherwise.
+const uint32_t kCapContiguousStorage    = 0x01u; //!< Elements are stored contiguously and can be accessed through a pointer
+const uint32_t kCapTriviallyRelocatable = 0x02u; //!< Elements can be copied and moved with memcpy()
+const uint32_t kCapBulkInsert           = 0x04u; //!< Ranges and fills of elements are inserted with one call
+const uint32_t kCapNativeAlgorithms     = 0x08u; //!< Traversals (visitors, flat export/import) run inside the implementing module
+const uint32_t kCapThreadSafeReads      = 0x10u; //!< Const functions may be called concurrently from several threads
+const uint32_t kCapSameToolchain        = 0x20u; //!< The implementation was built with the caller's compiler and standard library
+
+//! \def lia_TOOLCHAIN_ID
+//! \hideinitializer
+//! String that identifies the compiler and the standard library configuration of the current build environment.
+//! Modules with the same toolchain id report kCapSameToolchain to each other (see lia_PRIVATE_HEAP for the exception).
+//! Can be overridden by defining it before including any lia header.
+#ifndef lia_TOOLCHAIN_ID
+	#if defined(__clang__)
+		#define lia_TOOLCHAIN_COMPILER "clang-" lia_STRINGIFY(__clang_major__) "." lia_STRINGIFY(__clang_minor__)
+	#elif defined(__GNUC__)
+		#define lia_TOOLCHAIN_COMPILER "gcc-" lia_STRINGIFY(__GNUC__) "." lia_STRINGIFY(__GNUC_MINOR__)
+	#elif defined(_MSC_VER)
+		#define lia_TOOLCHAIN_COMPILER "msvc-" lia_STRINGIFY(_MSC_VER)
+	#else
+		#define lia_TOOLCHAIN_COMPILER "unknown"
+	#endif
+	#if defined(_LIBCPP_VERSION)
+		#define lia_TOOLCHAIN_STDLIB "libc++-" lia_STRINGIFY(_LIBCPP_VERSION)
+	#elif defined(__GLIBCXX__)
+		#if defined(_GLIBCXX_DEBUG)
+			#define lia_TOOLCHAIN_STDLIB "libstdc++-" lia_STRINGIFY(__GLIBCXX__) "-abi" lia_STRINGIFY(_GLIBCXX_USE_CXX11_ABI) "-debug"
+		#else
+			#define lia_TOOLCHAIN_STDLIB "libstdc++-" lia_STRINGIFY(__GLIBCXX__) "-abi" lia_STRINGIFY(_GLIBCXX_USE_CXX11_ABI)
+		#endif
+	#elif defined(_MSC_VER)
+		#if defined(_DLL) && defined(_DEBUG) // the debug and release runtime DLLs have different heaps
+			#define lia_TOOLCHAIN_STDLIB "msvcstl-idl" lia_STRINGIFY(_ITERATOR_DEBUG_LEVEL) "-mdd"
+		#elif defined(_DLL)
+			#define lia_TOOLCHAIN_STDLIB "msvcstl-idl" lia_STRINGIFY(_ITERATOR_DEBUG_LEVEL) "-md"
+		#elif defined(_DEBUG)
+			#define lia_TOOLCHAIN_STDLIB "msvcstl-idl" lia_STRINGIFY(_ITERATOR_DEBUG_LEVEL) "-mtd"
+		#else
+			#define lia_TOOLCHAIN_STDLIB "msvcstl-idl" lia_STRINGIFY(_ITERATOR_DEBUG_LEVEL) "-mt"
+		#endif
+	#else
+		#define lia_TOOLCHAIN_STDLIB "unknown"
+	#endif
+	#define lia_TOOLCHAIN_ID lia_TOOLCHAIN_COMPILER "/" lia_TOOLCHAIN_STDLIB "/" lia_STRINGIFY(lia_WORD_WIDTH)
+#endif
+
+//! \def lia_PRIVATE_HEAP
+//! \hideinitializer
+//! 1 if each module has a heap of its own, which is the case for a static C runtime on Windows. Objects of the
+//! standard library are never handed to other modules then (no kCapSameToolchain), whatever lia_TOOLCHAIN_ID is.
+#ifndef lia_PRIVATE_HEAP
+	#if defined(_MSC_VER) && !defined(_DLL)
+		#define lia_PRIVATE_HEAP 1
+	#else
+		#define lia_PRIVATE_HEAP 0
+	#endif
+#endif
+
+namespace detail {
+
+// Returns kCapSameToolchain when the caller of an abiGetCapabilities() function was built like this module. Never for
+// modules with a static C runtime: Each of them has a heap of its own, even if they have the same lia_TOOLCHAIN_ID.
+inline uint32_t getToolchainCapability(const char* pCallerToolchainId) lia_NOEXCEPT {
+#if lia_PRIVATE_HEAP
+	(void)pCallerToolchainId;
+	return 0u;
+#else
+	return ((pCallerToolchainId != lia_NULLPTR) && (std::strcmp(pCallerToolchainId, lia_TOOLCHAIN_ID) == 0)) ? kCapSameToolchain : 0u;
+#endif
+}
+
+// Identifies the type T by the signature of this function, which contains the name of T. Doesn't need RTTI, but
+// the ids of two modules can only be compared when they have the same lia_TOOLCHAIN_ID.
+template<typename T>
+struct TypeId {
+	static const char* get() lia_NOEXCEPT {
+#ifdef _MSC_VER
+		return __FUNCSIG__;
+#else
+		return __PRETTY_FUNCTION__;
+#endif
+	}
+};
+
+// Whether the caller of an abiGetNativeObject() function was built like this module and asks for an object of type T
+template<typename T>
+bool isNativeTypeOfCaller(const char* pCallerToolchainId, const char* pCallerTypeId) lia_NOEXCEPT {
+	return (getToolchainCapability(pCallerToolchainId) != 0u) && (pCallerTypeId != lia_NULLPTR) && (std::strcmp(pCallerTypeId, TypeId<T>::get()) == 0);
+}
+
+}
+
 //! \def lia_HAS_EXPECTED_WCHAR_T_SIZE
 //! \hideinitializer
 //! Is defined to one (1) when wchar_t is 16 bits under windows and 32 bits under linux (unsigned) for the currently used build environment,
@@ -419,15 +554,171 @@ struct IfThenElse<false, Then, Else> {
 
 struct Incomplete;
 
+// Type for tag dispatching on compile time conditions (re-implementation of std::integral_constant<bool, b>)
+template<bool b>
+struct BoolType {
+	static const bool value = b;
+};
+
+// Callback types for visiting the elements of a container inside the module that owns it. Elements of types
+// other than lia interfaces are passed as a pointer to n consecutive elements, lia interfaces as an array of
+// n proxies. A callback returns abi_false to stop the traversal.
+template<typename T, bool isContiguous = !IsLiaInterface<typename RemoveConst<T>::type>::value>
+struct VisitTypes {
+	typedef T*       Chunk;
+	typedef const T* ConstChunk;
+	typedef abi_bool_t (lia_CALL *Function)(void* pContext, Chunk pElems, abi_size_t n);
+	typedef abi_bool_t (lia_CALL *ConstFunction)(void* pContext, ConstChunk pElems, abi_size_t n);
+};
+
+template<typename T>
+struct VisitTypes<T, false> {
+	typedef typename MakeTypes<T>::Pointer*      Chunk;
+	typedef typename MakeTypes<T>::ConstPointer* ConstChunk;
+	typedef abi_bool_t (lia_CALL *Function)(void* pContext, Chunk pElems, abi_size_t n);
+	typedef abi_bool_t (lia_CALL *ConstFunction)(void* pContext, ConstChunk pElems, abi_size_t n);
+};
+
+// Callback type for comparisons inside the module that owns a container. The callback returns a positive value if
+// the comparison holds for the elements pA and pB point to (like 'pA is less than pB' for sorting or 'pA equals pB'
+// for removing duplicates), zero if it doesn't, and a negative value to abort.
+template<typename T>
+struct CompareTypes {
+	typedef int32_t (lia_CALL *Function)(void* pContext, typename MakeTypes<T>::ConstPointer& pA, typename MakeTypes<T>::ConstPointer& pB);
+};
+
+// Callback type for predicates inside the module that owns a container. The callback returns a positive value if
+// the predicate is true for the element pElem points to, zero if it isn't, and a negative value to abort.
+template<typename T>
+struct PredicateTypes {
+	typedef int32_t (lia_CALL *Function)(void* pContext, typename MakeTypes<T>::ConstPointer& pElem);
+};
+
+// Element type of the flat values buffer when a container of containers is exported in compressed sparse row
+// format. Only specialized for containers whose elements are containers of contiguous elements.
+template<typename T>
+struct FlatTypes {
+	static const bool isFlattenable = false;
+	typedef Incomplete Value;
+};
+
+#if !lia_CPP11_API
+// Without std::is_trivially_copyable, elements are never copied with memcpy()
+template<typename T>
+struct IsTriviallyRelocatable {
+	static const bool value = false;
+};
+
+template<typename T>
+struct IsBitwiseComparable {
+	static const bool value = false;
+};
+
+template<typename T>
+struct IsArithmetic {
+	static const bool value = false;
+};
+
+// Without decltype, operators can't be detected, and implementations never compare elements without a callback
+template<typename T>
+struct HasLess {
+	static const bool value = false;
+};
+
+template<typename T>
+struct HasEqual {
+	static const bool value = false;
+};
+#endif
+
+// Mixes the n bytes at p into the hash h, 8 bytes at a time. Hashing a block of memory in pieces gives the same
+// result as hashing it at once, as long as all pieces but the last one consist of a multiple of 8 bytes.
+inline uint64_t hashBytes(uint64_t h, const void* p, std::size_t n) lia_NOEXCEPT {
+	const unsigned char* pBytes = static_cast<const unsigned char*>(p);
+	while (n > 0u) {
+		uint64_t word = 0u;
+		const std::size_t num = (n < sizeof(word)) ? n : sizeof(word);
+		std::memcpy(&word, pBytes, num);
+		h ^= word * 0x9E3779B97F4A7C15ull;
+		h  = ((h << 31) | (h >> 33)) * 0xC2B2AE3D27D4EB4Full;
+		pBytes += num;
+		n      -= num;
+	}
+	return h;
+}
+
+inline uint64_t hashCombine(uint64_t h, uint64_t value) lia_NOEXCEPT {
+	return hashBytes(h, &value, sizeof(value));
+}
+
+// Final avalanche, so that all bits of the result depend on all bytes
+inline uint64_t hashFinalize(uint64_t h) lia_NOEXCEPT {
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDull;
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ull;
+	h ^= h >> 33;
+	return h;
+}
+
 }
 
 }
 
 #if lia_CPP11_API
 #include <initializer_list>
+#include <type_traits>
+#include <utility>
 namespace lia {
 namespace detail {
 
+// Whether elements of type T can be copied with memcpy(), see kCapTriviallyRelocatable
+template<typename T>
+struct IsTriviallyRelocatable {
+	static const bool value = std::is_trivially_copyable<T>::value && !IsLiaInterface<typename RemoveConst<T>::type>::value;
+};
+
+// Whether elements of type T are equal exactly when their bytes are equal, so that they can be compared with memcmp()
+// and hashed as a block of memory. That's not the case for floating point types (0.0 == -0.0) or types with padding.
+template<typename T>
+struct IsBitwiseComparable {
+#if lia_CPP17_API
+	static const bool value = std::has_unique_object_representations<T>::value;
+#else
+	static const bool value = std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value;
+#endif
+};
+
+// Whether T is an integral or floating point type, for which loops over elements are written so that compilers vectorize them
+template<typename T>
+struct IsArithmetic {
+	static const bool value = std::is_arithmetic<T>::value;
+};
+
+// Whether a < b and a == b compile for elements of type T. Implementations use the operators for the algorithms that are
+// called without a comparator, and report failure for element types that don't have them.
+template<typename T>
+struct HasLess {
+private:
+	template<typename U>
+	static char test(decltype(static_cast<bool>(std::declval<const U&>() < std::declval<const U&>()))*);
+	template<typename U>
+	static long test(...);
+public:
+	static const bool value = (sizeof(test<T>(nullptr)) == sizeof(char));
+};
+
+template<typename T>
+struct HasEqual {
+private:
+	template<typename U>
+	static char test(decltype(static_cast<bool>(std::declval<const U&>() == std::declval<const U&>()))*);
+	template<typename U>
+	static long test(...);
+public:
+	static const bool value = (sizeof(test<T>(nullptr)) == sizeof(char));
+};
+
 template<typename T>
 struct IsInitializerList {
 	static const bool value = false;
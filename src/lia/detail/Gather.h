@@ -0,0 +1,173 @@
+/*
++-----------------------------------+
+|                                   |
+|                 A                 |
+|                A A                |
+|               A   A               |
+|              A     A              |
+|  #  AAAAAAAAAAAAAAAAAAAAAAAAA  #  |
+|  ###       A         A       ###  |
+|  ######   A           A    #####  |
+|  ####### A             A #######  |
+|                                   |
++-----------------------------------+
+
+L I B A C R O S S - Using C++ containers
+ across DLL- and ABI-stable boundaries
+
+If you like this project, please refer to it with a link or
+some other reference. You can use this ASCII art icon as well
+as the supplied graphical icons for that purpose.
+
+(c) Copyright 2019 Jens Ganter-Benzing
+
+Licensed under the MIT license:
+
+http://www.opensource.org/licenses/mit-license.php
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#ifndef lia_detail_Gather_h_INCLUDED
+#define lia_detail_Gather_h_INCLUDED
+
+#ifdef __cplusplus
+	#include <cstddef>
+#endif
+#include <lia/defs.h>
+#include <lia/detail/Reduce.h>
+
+// The AVX2 gather instructions take 64 bit indices only on 64 bit targets, where abi_size_t has 64 bits
+#if lia_SIMD_X86 && (defined(__x86_64__) || defined(_M_X64))
+	#define lia_SIMD_GATHER 1
+#else
+	#define lia_SIMD_GATHER 0
+#endif
+
+#include <lia/detail/PushWarnings.h>
+
+#ifdef __cplusplus
+
+namespace lia {
+namespace detail {
+
+// Whether all n indices are less than size. Gathering and scattering check all indices before accessing any element,
+// so that an invalid index leaves both sides unchanged. The loop has no early exit, so that it can be vectorized.
+inline bool areValidIndices(const abi_size_t* pIndices, std::size_t n, std::size_t size) lia_NOEXCEPT {
+	abi_size_t maxIndex = 0;
+	for (std::size_t i=0; i<n; ++i) {
+		maxIndex = (pIndices[i] > maxIndex) ? pIndices[i] : maxIndex;
+	}
+	return (n == 0u) || (static_cast<std::size_t>(maxIndex) < size);
+}
+
+template<typename U, typename V>
+void gatherScalar(const U* pData, const abi_size_t* pIndices, std::size_t n, V* pOut) {
+	for (std::size_t i=0; i<n; ++i) {
+		pOut[i] = pData[static_cast<std::size_t>(pIndices[i])];
+	}
+}
+
+// Assigns pValues[i] to pData[pIndices[i]] for the n checked indices. There's no SIMD kernel, since AVX2 has no
+// scatter instructions.
+template<typename U, typename V>
+void scatterValues(U* pData, const abi_size_t* pIndices, std::size_t n, const V* pValues) {
+	for (std::size_t i=0; i<n; ++i) {
+		pData[static_cast<std::size_t>(pIndices[i])] = pValues[i];
+	}
+}
+
+#if lia_SIMD_GATHER
+
+// AVX2 kernels for elements of 4 and 8 bytes, which gather 8 elements per iteration and return the number of gathered
+// elements. The remaining ones are copied with their own type by the caller.
+lia_TARGET_AVX2 inline std::size_t gather32Avx2(const void* pData, const abi_size_t* pIndices, std::size_t n, void* pOut) {
+	const int* pBase = static_cast<const int*>(pData);
+	char* pDst = static_cast<char*>(pOut);
+	std::size_t i = 0;
+	for (; (n - i) >= 8u; i += 8u) {
+		const __m128i lo = _mm256_i64gather_epi32(pBase, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIndices + i)), 4);
+		const __m128i hi = _mm256_i64gather_epi32(pBase, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIndices + i + 4u)), 4);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + (i * 4u)), lo);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + (i * 4u) + 16u), hi);
+	}
+	return i;
+}
+
+lia_TARGET_AVX2 inline std::size_t gather64Avx2(const void* pData, const abi_size_t* pIndices, std::size_t n, void* pOut) {
+	const long long* pBase = static_cast<const long long*>(pData);
+	char* pDst = static_cast<char*>(pOut);
+	std::size_t i = 0;
+	for (; (n - i) >= 8u; i += 8u) {
+		const __m256i lo = _mm256_i64gather_epi64(pBase, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIndices + i)), 8);
+		const __m256i hi = _mm256_i64gather_epi64(pBase, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIndices + i + 4u)), 8);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + (i * 8u)), lo);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + (i * 8u) + 32u), hi);
+	}
+	return i;
+}
+
+#endif
+
+// Selects the kernel by the size of trivially copyable elements. Sizes without kernel gather nothing.
+template<std::size_t elemSize>
+struct GatherKernel {
+	static std::size_t gather(const void*, const abi_size_t*, std::size_t, void*) lia_NOEXCEPT {
+		return 0u;
+	}
+};
+
+#if lia_SIMD_GATHER
+
+template<>
+struct GatherKernel<4u> {
+	static std::size_t gather(const void* pData, const abi_size_t* pIndices, std::size_t n, void* pOut) lia_NOEXCEPT {
+		return (getSimdLevel() >= kSimdAvx2) ? gather32Avx2(pData, pIndices, n, pOut) : 0u;
+	}
+};
+
+template<>
+struct GatherKernel<8u> {
+	static std::size_t gather(const void* pData, const abi_size_t* pIndices, std::size_t n, void* pOut) lia_NOEXCEPT {
+		return (getSimdLevel() >= kSimdAvx2) ? gather64Avx2(pData, pIndices, n, pOut) : 0u;
+	}
+};
+
+#endif
+
+// Copies pData[pIndices[i]] to pOut[i] for the n checked indices. Elements are gathered with SIMD kernels if they are
+// trivially copyable and the output has the same type.
+template<typename U, typename V>
+void gatherValues(const U* pData, const abi_size_t* pIndices, std::size_t n, V* pOut) {
+	gatherScalar(pData, pIndices, n, pOut);
+}
+
+template<typename U>
+void gatherValues(const U* pData, const abi_size_t* pIndices, std::size_t n, U* pOut) {
+	const std::size_t i = GatherKernel<IsTriviallyRelocatable<U>::value ? sizeof(U) : 0u>::gather(pData, pIndices, n, pOut);
+	gatherScalar(pData, pIndices + i, n - i, pOut + i);
+}
+
+}
+}
+
+#endif
+
+#include <lia/detail/PopWarnings.h>
+
+#endif
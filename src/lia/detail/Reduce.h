@@ -0,0 +1,1004 @@
+/*
++-----------------------------------+
+|                                   |
+|                 A                 |
+|                A A                |
+|               A   A               |
+|              A     A              |
+|  #  AAAAAAAAAAAAAAAAAAAAAAAAA  #  |
+|  ###       A         A       ###  |
+|  ######   A           A    #####  |
+|  ####### A             A #######  |
+|                                   |
++-----------------------------------+
+
+L I B A C R O S S - Using C++ containers
+ across DLL- and ABI-stable boundaries
+
+If you like this project, please refer to it with a link or
+some other reference. You can use this ASCII art icon as well
+as the supplied graphical icons for that purpose.
+
+(c) Copyright 2019 Jens Ganter-Benzing
+
+Licensed under the MIT license:
+
+http://www.opensource.org/licenses/mit-license.php
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#ifndef lia_detail_Reduce_h_INCLUDED
+#define lia_detail_Reduce_h_INCLUDED
+
+#ifdef __cplusplus
+	#include <cstddef>
+	#include <limits>
+#endif
+#include <lia/defs.h>
+#include <lia/detail/Search.h>
+
+// SSE2 kernels are used where SSE2 is part of the target architecture, AVX2 kernels are selected at runtime.
+// Define lia_NO_SIMD to use the portable loops only.
+#if defined(__cplusplus) && !defined(lia_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+	#define lia_SIMD_X86 1
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+		#define lia_SIMD_SSE2 1
+	#else
+		#define lia_SIMD_SSE2 0
+	#endif
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#define lia_TARGET_AVX2
+	#else
+		#define lia_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+	#include <immintrin.h>
+#else
+	#define lia_SIMD_X86 0
+	#define lia_SIMD_SSE2 0
+#endif
+
+#include <lia/detail/PushWarnings.h>
+
+#ifdef __cplusplus
+
+namespace lia {
+namespace detail {
+
+// Result types of reductions. Integers are summed up as 64 bit integers, floating point values as double (or long
+// double). isAbiFixed is set for the types whose Sum and Value have the same layout for all compilers, which are the
+// only ones IVector::abiReduce() reduces in the module owning the vector. long is 32 bit on Win64 and long double is
+// 8 bytes with MSVC, so vectors of these are reduced on the side of the caller.
+template<typename T>
+struct ReduceTypes {
+	static const bool isReducible = false;
+	static const bool isAbiFixed  = false;
+	typedef Incomplete Sum;
+	typedef Incomplete Value;
+};
+
+#define lia_REDUCE_TYPES(TValue, TSum, abiFixed)  \
+	template<>                                    \
+	struct ReduceTypes<TValue> {                  \
+		static const bool isReducible = true;     \
+		static const bool isAbiFixed  = abiFixed; \
+		typedef TSum   Sum;                       \
+		typedef TValue Value;                     \
+	};
+
+lia_REDUCE_TYPES(char,               int64_t,     true)
+lia_REDUCE_TYPES(signed char,        int64_t,     true)
+lia_REDUCE_TYPES(unsigned char,      uint64_t,    true)
+lia_REDUCE_TYPES(short,              int64_t,     true)
+lia_REDUCE_TYPES(unsigned short,     uint64_t,    true)
+lia_REDUCE_TYPES(int,                int64_t,     true)
+lia_REDUCE_TYPES(unsigned int,       uint64_t,    true)
+lia_REDUCE_TYPES(long,               int64_t,     false)
+lia_REDUCE_TYPES(unsigned long,      uint64_t,    false)
+lia_REDUCE_TYPES(long long,          int64_t,     true)
+lia_REDUCE_TYPES(unsigned long long, uint64_t,    true)
+lia_REDUCE_TYPES(float,              double,      true)
+lia_REDUCE_TYPES(double,             double,      true)
+lia_REDUCE_TYPES(long double,        long double, false)
+
+#undef lia_REDUCE_TYPES
+
+const uint32_t kSimdNone = 0u;
+const uint32_t kSimdSse2 = 1u;
+const uint32_t kSimdAvx2 = 2u;
+
+inline uint32_t detectSimdLevel() lia_NOEXCEPT {
+#if lia_SIMD_X86
+	#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] >= 7) {
+		__cpuid(info, 1);
+		const bool hasAvx = ((info[2] & (1 << 27)) != 0) && ((info[2] & (1 << 28)) != 0) && ((_xgetbv(0) & 6u) == 6u); // OSXSAVE, AVX, OS saves ymm registers
+		__cpuidex(info, 7, 0);
+		if (hasAvx && ((info[1] & (1 << 5)) != 0)) {
+			return kSimdAvx2;
+		}
+	}
+	#else
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return kSimdAvx2;
+	}
+	#endif
+#endif
+	return lia_SIMD_SSE2 ? kSimdSse2 : kSimdNone;
+}
+
+// The instruction set extensions of the CPU, detected once per module
+inline uint32_t getSimdLevel() lia_NOEXCEPT {
+	static const uint32_t level = detectSimdLevel();
+	return level;
+}
+
+// Portable loops, with independent accumulators so that compilers can vectorize them or at least overlap the additions
+template<typename U>
+typename ReduceTypes<U>::Sum sumScalar(const U* pData, std::size_t n) {
+	typedef typename ReduceTypes<U>::Sum TSum;
+	TSum s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	std::size_t i = 0;
+	for (; (n - i) >= 4u; i += 4u) {
+		s0 += static_cast<TSum>(pData[i]);
+		s1 += static_cast<TSum>(pData[i + 1u]);
+		s2 += static_cast<TSum>(pData[i + 2u]);
+		s3 += static_cast<TSum>(pData[i + 3u]);
+	}
+	for (; i<n; ++i) {
+		s0 += static_cast<TSum>(pData[i]);
+	}
+	return (s0 + s1) + (s2 + s3);
+}
+
+template<typename U>
+typename ReduceTypes<U>::Sum dotScalar(const U* pA, const U* pB, std::size_t n) {
+	typedef typename ReduceTypes<U>::Sum TSum;
+	TSum s0 = 0, s1 = 0;
+	std::size_t i = 0;
+	for (; (n - i) >= 2u; i += 2u) {
+		s0 += static_cast<TSum>(pA[i]) * static_cast<TSum>(pB[i]);
+		s1 += static_cast<TSum>(pA[i + 1u]) * static_cast<TSum>(pB[i + 1u]);
+	}
+	for (; i<n; ++i) {
+		s0 += static_cast<TSum>(pA[i]) * static_cast<TSum>(pB[i]);
+	}
+	return s0 + s1;
+}
+
+// All kernels follow the same policy for NaN values: minimum and maximum are NaN if there's a NaN value, and the index
+// of the minimum or maximum is the index of the first NaN value. isNan() is constant false for integers.
+template<typename U>
+bool isNan(const U& x) {
+	return x != x;
+}
+
+template<typename U>
+U pickMin(const U& a, const U& b) {
+	return ((b < a) || isNan(b)) ? b : a;
+}
+
+template<typename U>
+U pickMax(const U& a, const U& b) {
+	return ((a < b) || isNan(b)) ? b : a;
+}
+
+// n must not be 0 for minScalar() and maxScalar()
+template<typename U>
+U minScalar(const U* pData, std::size_t n) {
+	U result = pData[0];
+	for (std::size_t i=1; i<n; ++i) {
+		result = pickMin(result, pData[i]);
+	}
+	return result;
+}
+
+template<typename U>
+U maxScalar(const U* pData, std::size_t n) {
+	U result = pData[0];
+	for (std::size_t i=1; i<n; ++i) {
+		result = pickMax(result, pData[i]);
+	}
+	return result;
+}
+
+// Returns the offset of the first minimum, or maximum if isMax is set, in one pass. Returns 0 if n is 0.
+template<typename U>
+std::size_t argMinMaxScalar(const U* pData, std::size_t n, bool isMax) {
+	std::size_t result = 0u;
+	for (std::size_t i=0; i<n; ++i) {
+		if (isNan(pData[i])) {
+			return i;
+		}
+		if (isMax ? (pData[result] < pData[i]) : (pData[i] < pData[result])) {
+			result = i;
+		}
+	}
+	return result;
+}
+
+// Finishes the index tracking kernels: combines the numLanes lanes, each holding the first minimum (or maximum) of
+// its elements and the index of it, and continues with the elements [i, n) that didn't fill a vector
+template<typename U, typename TIndex>
+std::size_t argMinMaxLanes(const U* pValues, const TIndex* pIndices, std::size_t numLanes, const U* pData, std::size_t i, std::size_t n, bool isMax) {
+	U value = pValues[0];
+	std::size_t result = static_cast<std::size_t>(pIndices[0]);
+	for (std::size_t k=1; k<numLanes; ++k) {
+		const std::size_t index = static_cast<std::size_t>(pIndices[k]);
+		const bool isBetter = isMax ? (value < pValues[k]) : (pValues[k] < value);
+		const bool isEqual = !(value < pValues[k]) && !(pValues[k] < value);
+		if (isBetter || (isEqual && (index < result))) {
+			value = pValues[k];
+			result = index;
+		}
+	}
+	for (; i<n; ++i) {
+		if (isNan(pData[i])) {
+			return i;
+		}
+		if (isMax ? (value < pData[i]) : (pData[i] < value)) {
+			value = pData[i];
+			result = i;
+		}
+	}
+	return result;
+}
+
+// Index of the lowest set bit of a non-zero movemask result
+inline std::size_t lowestLane(int mask) lia_NOEXCEPT {
+	std::size_t i = 0;
+	while (((mask >> i) & 1) == 0) {
+		++i;
+	}
+	return i;
+}
+
+// Kernels with 32 bit lane indices are called for chunks of at most 2^30 elements
+template<typename U>
+std::size_t argMinMaxChunked(const U* pData, std::size_t n, bool isMax, std::size_t (*pKernel)(const U*, std::size_t, bool)) {
+	const std::size_t kChunkSize = std::size_t(1) << 30;
+	std::size_t done = (n < kChunkSize) ? n : kChunkSize;
+	std::size_t result = (*pKernel)(pData, done, isMax);
+	while ((done < n) && !isNan(pData[result])) {
+		const std::size_t count = ((n - done) < kChunkSize) ? (n - done) : kChunkSize;
+		const std::size_t index = done + (*pKernel)(pData + done, count, isMax);
+		if (isNan(pData[index]) || (isMax ? (pData[result] < pData[index]) : (pData[index] < pData[result]))) {
+			result = index;
+		}
+		done += count;
+	}
+	return result;
+}
+
+#if lia_SIMD_SSE2
+
+// SSE2 kernels for the most common element types. SSE2 has no signed 32 bit minimum, maximum or 64 bit product,
+// so those are emulated or left to the portable loops.
+inline int64_t sumSse2(const int32_t* pData, std::size_t n) {
+	__m128i acc = _mm_setzero_si128();
+	std::size_t i = 0;
+	for (; (n - i) >= 4u; i += 4u) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+		const __m128i sign = _mm_srai_epi32(v, 31);
+		acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+		acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+	}
+	int64_t lanes[2];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+	return lanes[0] + lanes[1] + sumScalar(pData + i, n - i);
+}
+
+inline double sumSse2(const float* pData, std::size_t n) {
+	__m128d acc0 = _mm_setzero_pd();
+	__m128d acc1 = _mm_setzero_pd();
+	std::size_t i = 0;
+	for (; (n - i) >= 4u; i += 4u) {
+		const __m128 v = _mm_loadu_ps(pData + i);
+		acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(v));
+		acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+	return (lanes[0] + lanes[1]) + sumScalar(pData + i, n - i);
+}
+
+inline double sumSse2(const double* pData, std::size_t n) {
+	__m128d acc0 = _mm_setzero_pd();
+	__m128d acc1 = _mm_setzero_pd();
+	std::size_t i = 0;
+	for (; (n - i) >= 4u; i += 4u) {
+		acc0 = _mm_add_pd(acc0, _mm_loadu_pd(pData + i));
+		acc1 = _mm_add_pd(acc1, _mm_loadu_pd(pData + i + 2u));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+	return (lanes[0] + lanes[1]) + sumScalar(pData + i, n - i);
+}
+
+inline double dotSse2(const float* pA, const float* pB, std::size_t n) {
+	__m128d acc0 = _mm_setzero_pd();
+	__m128d acc1 = _mm_setzero_pd();
+	std::size_t i = 0;
+	for (; (n - i) >= 4u; i += 4u) {
+		const __m128 a = _mm_loadu_ps(pA + i);
+		const __m128 b = _mm_loadu_ps(pB + i);
+		acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_cvtps_pd(a), _mm_cvtps_pd(b)));
+		acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(a, a)), _mm_cvtps_pd(_mm_movehl_ps(b, b))));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+	return (lanes[0] + lanes[1]) + dotScalar(pA + i, pB + i, n - i);
+}
+
+inline double dotSse2(const double* pA, const double* pB, std::size_t n) {
+	__m128d acc0 = _mm_setzero_pd();
+	__m128d acc1 = _mm_setzero_pd();
+	std::size_t i = 0;
+	for (; (n - i) >= 4u; i += 4u) {
+		acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(pA + i), _mm_loadu_pd(pB + i)));
+		acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(pA + i + 2u), _mm_loadu_pd(pB + i + 2u)));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+	return (lanes[0] + lanes[1]) + dotScalar(pA + i, pB + i, n - i);
+}
+
+// isMax selects the maximum instead of the minimum. n must not be 0.
+inline int32_t minMaxSse2(const int32_t* pData, std::size_t n, bool isMax) {
+	if (n < 4u) {
+		return isMax ? maxScalar(pData, n) : minScalar(pData, n);
+	}
+	__m128i acc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData));
+	std::size_t i = 4u;
+	for (; (n - i) >= 4u; i += 4u) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+		const __m128i takeV = isMax ? _mm_cmpgt_epi32(v, acc) : _mm_cmplt_epi32(v, acc);
+		acc = _mm_or_si128(_mm_and_si128(takeV, v), _mm_andnot_si128(takeV, acc));
+	}
+	int32_t lanes[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+	int32_t result = isMax ? maxScalar(lanes, 4u) : minScalar(lanes, 4u);
+	if (i < n) {
+		const int32_t rest = isMax ? maxScalar(pData + i, n - i) : minScalar(pData + i, n - i);
+		result = isMax ? pickMax(result, rest) : pickMin(result, rest);
+	}
+	return result;
+}
+
+inline float minMaxSse2(const float* pData, std::size_t n, bool isMax) {
+	if (n < 4u) {
+		return isMax ? maxScalar(pData, n) : minScalar(pData, n);
+	}
+	__m128 acc = _mm_loadu_ps(pData);
+	__m128 nan = _mm_cmpunord_ps(acc, acc);
+	std::size_t i = 4u;
+	for (; (n - i) >= 4u; i += 4u) {
+		const __m128 v = _mm_loadu_ps(pData + i);
+		nan = _mm_or_ps(nan, _mm_cmpunord_ps(v, v));
+		acc = isMax ? _mm_max_ps(acc, v) : _mm_min_ps(acc, v);
+	}
+	if (_mm_movemask_ps(nan) != 0) {
+		return std::numeric_limits<float>::quiet_NaN();
+	}
+	float lanes[4];
+	_mm_storeu_ps(lanes, acc);
+	float result = isMax ? maxScalar(lanes, 4u) : minScalar(lanes, 4u);
+	if (i < n) {
+		const float rest = isMax ? maxScalar(pData + i, n - i) : minScalar(pData + i, n - i);
+		result = isMax ? pickMax(result, rest) : pickMin(result, rest);
+	}
+	return result;
+}
+
+inline double minMaxSse2(const double* pData, std::size_t n, bool isMax) {
+	if (n < 2u) {
+		return pData[0];
+	}
+	__m128d acc = _mm_loadu_pd(pData);
+	__m128d nan = _mm_cmpunord_pd(acc, acc);
+	std::size_t i = 2u;
+	for (; (n - i) >= 2u; i += 2u) {
+		const __m128d v = _mm_loadu_pd(pData + i);
+		nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+		acc = isMax ? _mm_max_pd(acc, v) : _mm_min_pd(acc, v);
+	}
+	if (_mm_movemask_pd(nan) != 0) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, acc);
+	double result = isMax ? maxScalar(lanes, 2u) : minScalar(lanes, 2u);
+	if (i < n) {
+		result = isMax ? pickMax(result, pData[i]) : pickMin(result, pData[i]);
+	}
+	return result;
+}
+
+// Index tracking kernels: every lane keeps its first minimum (or maximum) and the index of it. Vectors with a NaN
+// value end the search. The 32 bit lane indices limit n to 2^31 - 1, see argMinMaxChunked().
+inline std::size_t argMinMaxSse2(const int32_t* pData, std::size_t n, bool isMax) {
+	if (n < 8u) {
+		return argMinMaxScalar(pData, n, isMax);
+	}
+	__m128i best = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData));
+	__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+	__m128i bestIndex = index;
+	const __m128i step = _mm_set1_epi32(4);
+	std::size_t i = 4u;
+	for (; (n - i) >= 4u; i += 4u) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+		index = _mm_add_epi32(index, step);
+		const __m128i takeV = isMax ? _mm_cmpgt_epi32(v, best) : _mm_cmplt_epi32(v, best);
+		best = _mm_or_si128(_mm_and_si128(takeV, v), _mm_andnot_si128(takeV, best));
+		bestIndex = _mm_or_si128(_mm_and_si128(takeV, index), _mm_andnot_si128(takeV, bestIndex));
+	}
+	int32_t values[4];
+	int32_t indices[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(values), best);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(indices), bestIndex);
+	return argMinMaxLanes(values, indices, 4u, pData, i, n, isMax);
+}
+
+inline std::size_t argMinMaxSse2(const float* pData, std::size_t n, bool isMax) {
+	if (n < 8u) {
+		return argMinMaxScalar(pData, n, isMax);
+	}
+	__m128 best = _mm_loadu_ps(pData);
+	int nan = _mm_movemask_ps(_mm_cmpunord_ps(best, best));
+	if (nan != 0) {
+		return lowestLane(nan);
+	}
+	__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+	__m128i bestIndex = index;
+	const __m128i step = _mm_set1_epi32(4);
+	std::size_t i = 4u;
+	for (; (n - i) >= 4u; i += 4u) {
+		const __m128 v = _mm_loadu_ps(pData + i);
+		nan = _mm_movemask_ps(_mm_cmpunord_ps(v, v));
+		if (nan != 0) {
+			return i + lowestLane(nan);
+		}
+		index = _mm_add_epi32(index, step);
+		const __m128 takeV = isMax ? _mm_cmplt_ps(best, v) : _mm_cmplt_ps(v, best);
+		const __m128i takeIndex = _mm_castps_si128(takeV);
+		best = _mm_or_ps(_mm_and_ps(takeV, v), _mm_andnot_ps(takeV, best));
+		bestIndex = _mm_or_si128(_mm_and_si128(takeIndex, index), _mm_andnot_si128(takeIndex, bestIndex));
+	}
+	float values[4];
+	int32_t indices[4];
+	_mm_storeu_ps(values, best);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(indices), bestIndex);
+	return argMinMaxLanes(values, indices, 4u, pData, i, n, isMax);
+}
+
+// The lane indices are doubles, which are exact for all sizes of arrays of doubles
+inline std::size_t argMinMaxSse2(const double* pData, std::size_t n, bool isMax) {
+	if (n < 4u) {
+		return argMinMaxScalar(pData, n, isMax);
+	}
+	__m128d best = _mm_loadu_pd(pData);
+	int nan = _mm_movemask_pd(_mm_cmpunord_pd(best, best));
+	if (nan != 0) {
+		return lowestLane(nan);
+	}
+	__m128d index = _mm_setr_pd(0.0, 1.0);
+	__m128d bestIndex = index;
+	const __m128d step = _mm_set1_pd(2.0);
+	std::size_t i = 2u;
+	for (; (n - i) >= 2u; i += 2u) {
+		const __m128d v = _mm_loadu_pd(pData + i);
+		nan = _mm_movemask_pd(_mm_cmpunord_pd(v, v));
+		if (nan != 0) {
+			return i + lowestLane(nan);
+		}
+		index = _mm_add_pd(index, step);
+		const __m128d takeV = isMax ? _mm_cmplt_pd(best, v) : _mm_cmplt_pd(v, best);
+		best = _mm_or_pd(_mm_and_pd(takeV, v), _mm_andnot_pd(takeV, best));
+		bestIndex = _mm_or_pd(_mm_and_pd(takeV, index), _mm_andnot_pd(takeV, bestIndex));
+	}
+	double values[2];
+	double indices[2];
+	_mm_storeu_pd(values, best);
+	_mm_storeu_pd(indices, bestIndex);
+	return argMinMaxLanes(values, indices, 2u, pData, i, n, isMax);
+}
+
+#endif
+
+#if lia_SIMD_X86
+
+// AVX2 kernels, which are compiled for AVX2 independently of the compiler flags and only called if the CPU supports it
+lia_TARGET_AVX2 inline int64_t sumAvx2(const int32_t* pData, std::size_t n) {
+	__m256i acc = _mm256_setzero_si256();
+	std::size_t i = 0;
+	for (; (n - i) >= 8u; i += 8u) {
+		acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i))));
+		acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i + 4u))));
+	}
+	int64_t lanes[4];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+	return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + sumScalar(pData + i, n - i);
+}
+
+lia_TARGET_AVX2 inline double sumAvx2(const float* pData, std::size_t n) {
+	__m256d acc0 = _mm256_setzero_pd();
+	__m256d acc1 = _mm256_setzero_pd();
+	std::size_t i = 0;
+	for (; (n - i) >= 8u; i += 8u) {
+		acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm_loadu_ps(pData + i)));
+		acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm_loadu_ps(pData + i + 4u)));
+	}
+	double lanes[4];
+	_mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+	return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + sumScalar(pData + i, n - i);
+}
+
+lia_TARGET_AVX2 inline double sumAvx2(const double* pData, std::size_t n) {
+	__m256d acc0 = _mm256_setzero_pd();
+	__m256d acc1 = _mm256_setzero_pd();
+	std::size_t i = 0;
+	for (; (n - i) >= 8u; i += 8u) {
+		acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(pData + i));
+		acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(pData + i + 4u));
+	}
+	double lanes[4];
+	_mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+	return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + sumScalar(pData + i, n - i);
+}
+
+lia_TARGET_AVX2 inline int64_t dotAvx2(const int32_t* pA, const int32_t* pB, std::size_t n) {
+	__m256i acc = _mm256_setzero_si256();
+	std::size_t i = 0;
+	for (; (n - i) >= 4u; i += 4u) {
+		const __m256i a = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pA + i)));
+		const __m256i b = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pB + i)));
+		acc = _mm256_add_epi64(acc, _mm256_mul_epi32(a, b));
+	}
+	int64_t lanes[4];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+	return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + dotScalar(pA + i, pB + i, n - i);
+}
+
+lia_TARGET_AVX2 inline double dotAvx2(const float* pA, const float* pB, std::size_t n) {
+	__m256d acc0 = _mm256_setzero_pd();
+	__m256d acc1 = _mm256_setzero_pd();
+	std::size_t i = 0;
+	for (; (n - i) >= 8u; i += 8u) {
+		acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(pA + i)), _mm256_cvtps_pd(_mm_loadu_ps(pB + i))));
+		acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(pA + i + 4u)), _mm256_cvtps_pd(_mm_loadu_ps(pB + i + 4u))));
+	}
+	double lanes[4];
+	_mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+	return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + dotScalar(pA + i, pB + i, n - i);
+}
+
+lia_TARGET_AVX2 inline double dotAvx2(const double* pA, const double* pB, std::size_t n) {
+	__m256d acc0 = _mm256_setzero_pd();
+	__m256d acc1 = _mm256_setzero_pd();
+	std::size_t i = 0;
+	for (; (n - i) >= 8u; i += 8u) {
+		acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(pA + i), _mm256_loadu_pd(pB + i)));
+		acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(pA + i + 4u), _mm256_loadu_pd(pB + i + 4u)));
+	}
+	double lanes[4];
+	_mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+	return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + dotScalar(pA + i, pB + i, n - i);
+}
+
+lia_TARGET_AVX2 inline int32_t minMaxAvx2(const int32_t* pData, std::size_t n, bool isMax) {
+	if (n < 8u) {
+		return isMax ? maxScalar(pData, n) : minScalar(pData, n);
+	}
+	__m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData));
+	std::size_t i = 8u;
+	for (; (n - i) >= 8u; i += 8u) {
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + i));
+		acc = isMax ? _mm256_max_epi32(acc, v) : _mm256_min_epi32(acc, v);
+	}
+	int32_t lanes[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+	int32_t result = isMax ? maxScalar(lanes, 8u) : minScalar(lanes, 8u);
+	if (i < n) {
+		const int32_t rest = isMax ? maxScalar(pData + i, n - i) : minScalar(pData + i, n - i);
+		result = isMax ? pickMax(result, rest) : pickMin(result, rest);
+	}
+	return result;
+}
+
+lia_TARGET_AVX2 inline float minMaxAvx2(const float* pData, std::size_t n, bool isMax) {
+	if (n < 8u) {
+		return isMax ? maxScalar(pData, n) : minScalar(pData, n);
+	}
+	__m256 acc = _mm256_loadu_ps(pData);
+	__m256 nan = _mm256_cmp_ps(acc, acc, _CMP_UNORD_Q);
+	std::size_t i = 8u;
+	for (; (n - i) >= 8u; i += 8u) {
+		const __m256 v = _mm256_loadu_ps(pData + i);
+		nan = _mm256_or_ps(nan, _mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+		acc = isMax ? _mm256_max_ps(acc, v) : _mm256_min_ps(acc, v);
+	}
+	if (_mm256_movemask_ps(nan) != 0) {
+		return std::numeric_limits<float>::quiet_NaN();
+	}
+	float lanes[8];
+	_mm256_storeu_ps(lanes, acc);
+	float result = isMax ? maxScalar(lanes, 8u) : minScalar(lanes, 8u);
+	if (i < n) {
+		const float rest = isMax ? maxScalar(pData + i, n - i) : minScalar(pData + i, n - i);
+		result = isMax ? pickMax(result, rest) : pickMin(result, rest);
+	}
+	return result;
+}
+
+lia_TARGET_AVX2 inline double minMaxAvx2(const double* pData, std::size_t n, bool isMax) {
+	if (n < 4u) {
+		return isMax ? maxScalar(pData, n) : minScalar(pData, n);
+	}
+	__m256d acc = _mm256_loadu_pd(pData);
+	__m256d nan = _mm256_cmp_pd(acc, acc, _CMP_UNORD_Q);
+	std::size_t i = 4u;
+	for (; (n - i) >= 4u; i += 4u) {
+		const __m256d v = _mm256_loadu_pd(pData + i);
+		nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+		acc = isMax ? _mm256_max_pd(acc, v) : _mm256_min_pd(acc, v);
+	}
+	if (_mm256_movemask_pd(nan) != 0) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	double lanes[4];
+	_mm256_storeu_pd(lanes, acc);
+	double result = isMax ? maxScalar(lanes, 4u) : minScalar(lanes, 4u);
+	if (i < n) {
+		const double rest = isMax ? maxScalar(pData + i, n - i) : minScalar(pData + i, n - i);
+		result = isMax ? pickMax(result, rest) : pickMin(result, rest);
+	}
+	return result;
+}
+
+lia_TARGET_AVX2 inline std::size_t argMinMaxAvx2(const int32_t* pData, std::size_t n, bool isMax) {
+	if (n < 16u) {
+		return argMinMaxScalar(pData, n, isMax);
+	}
+	__m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData));
+	__m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256i bestIndex = index;
+	const __m256i step = _mm256_set1_epi32(8);
+	std::size_t i = 8u;
+	for (; (n - i) >= 8u; i += 8u) {
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + i));
+		index = _mm256_add_epi32(index, step);
+		const __m256i takeV = isMax ? _mm256_cmpgt_epi32(v, best) : _mm256_cmpgt_epi32(best, v);
+		best = _mm256_blendv_epi8(best, v, takeV);
+		bestIndex = _mm256_blendv_epi8(bestIndex, index, takeV);
+	}
+	int32_t values[8];
+	int32_t indices[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(values), best);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(indices), bestIndex);
+	return argMinMaxLanes(values, indices, 8u, pData, i, n, isMax);
+}
+
+lia_TARGET_AVX2 inline std::size_t argMinMaxAvx2(const float* pData, std::size_t n, bool isMax) {
+	if (n < 16u) {
+		return argMinMaxScalar(pData, n, isMax);
+	}
+	__m256 best = _mm256_loadu_ps(pData);
+	int nan = _mm256_movemask_ps(_mm256_cmp_ps(best, best, _CMP_UNORD_Q));
+	if (nan != 0) {
+		return lowestLane(nan);
+	}
+	__m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256i bestIndex = index;
+	const __m256i step = _mm256_set1_epi32(8);
+	std::size_t i = 8u;
+	for (; (n - i) >= 8u; i += 8u) {
+		const __m256 v = _mm256_loadu_ps(pData + i);
+		nan = _mm256_movemask_ps(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+		if (nan != 0) {
+			return i + lowestLane(nan);
+		}
+		index = _mm256_add_epi32(index, step);
+		const __m256 takeV = isMax ? _mm256_cmp_ps(best, v, _CMP_LT_OQ) : _mm256_cmp_ps(v, best, _CMP_LT_OQ);
+		best = _mm256_blendv_ps(best, v, takeV);
+		bestIndex = _mm256_blendv_epi8(bestIndex, index, _mm256_castps_si256(takeV));
+	}
+	float values[8];
+	int32_t indices[8];
+	_mm256_storeu_ps(values, best);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(indices), bestIndex);
+	return argMinMaxLanes(values, indices, 8u, pData, i, n, isMax);
+}
+
+lia_TARGET_AVX2 inline std::size_t argMinMaxAvx2(const double* pData, std::size_t n, bool isMax) {
+	if (n < 8u) {
+		return argMinMaxScalar(pData, n, isMax);
+	}
+	__m256d best = _mm256_loadu_pd(pData);
+	int nan = _mm256_movemask_pd(_mm256_cmp_pd(best, best, _CMP_UNORD_Q));
+	if (nan != 0) {
+		return lowestLane(nan);
+	}
+	__m256d index = _mm256_setr_pd(0.0, 1.0, 2.0, 3.0);
+	__m256d bestIndex = index;
+	const __m256d step = _mm256_set1_pd(4.0);
+	std::size_t i = 4u;
+	for (; (n - i) >= 4u; i += 4u) {
+		const __m256d v = _mm256_loadu_pd(pData + i);
+		nan = _mm256_movemask_pd(_mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+		if (nan != 0) {
+			return i + lowestLane(nan);
+		}
+		index = _mm256_add_pd(index, step);
+		const __m256d takeV = isMax ? _mm256_cmp_pd(best, v, _CMP_LT_OQ) : _mm256_cmp_pd(v, best, _CMP_LT_OQ);
+		best = _mm256_blendv_pd(best, v, takeV);
+		bestIndex = _mm256_blendv_pd(bestIndex, index, takeV);
+	}
+	double values[4];
+	double indices[4];
+	_mm256_storeu_pd(values, best);
+	_mm256_storeu_pd(indices, bestIndex);
+	return argMinMaxLanes(values, indices, 4u, pData, i, n, isMax);
+}
+
+#endif
+
+// Selects the fastest kernel for the element type and CPU. Element types without kernels use the portable loops.
+template<typename U>
+typename ReduceTypes<U>::Sum sumValues(const U* pData, std::size_t n) {
+	return sumScalar(pData, n);
+}
+
+template<typename U>
+typename ReduceTypes<U>::Sum dotValues(const U* pA, const U* pB, std::size_t n) {
+	return dotScalar(pA, pB, n);
+}
+
+template<typename U>
+U minMaxValues(const U* pData, std::size_t n, bool isMax) {
+	return isMax ? maxScalar(pData, n) : minScalar(pData, n);
+}
+
+template<typename U>
+std::size_t argMinMaxValues(const U* pData, std::size_t n, bool isMax) {
+	return argMinMaxScalar(pData, n, isMax);
+}
+
+#if lia_SIMD_X86
+
+inline int64_t sumValues(const int32_t* pData, std::size_t n) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return sumAvx2(pData, n);
+	}
+#if lia_SIMD_SSE2
+	return sumSse2(pData, n);
+#else
+	return sumScalar(pData, n);
+#endif
+}
+
+inline double sumValues(const float* pData, std::size_t n) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return sumAvx2(pData, n);
+	}
+#if lia_SIMD_SSE2
+	return sumSse2(pData, n);
+#else
+	return sumScalar(pData, n);
+#endif
+}
+
+inline double sumValues(const double* pData, std::size_t n) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return sumAvx2(pData, n);
+	}
+#if lia_SIMD_SSE2
+	return sumSse2(pData, n);
+#else
+	return sumScalar(pData, n);
+#endif
+}
+
+inline int64_t dotValues(const int32_t* pA, const int32_t* pB, std::size_t n) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return dotAvx2(pA, pB, n);
+	}
+	return dotScalar(pA, pB, n);
+}
+
+inline double dotValues(const float* pA, const float* pB, std::size_t n) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return dotAvx2(pA, pB, n);
+	}
+#if lia_SIMD_SSE2
+	return dotSse2(pA, pB, n);
+#else
+	return dotScalar(pA, pB, n);
+#endif
+}
+
+inline double dotValues(const double* pA, const double* pB, std::size_t n) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return dotAvx2(pA, pB, n);
+	}
+#if lia_SIMD_SSE2
+	return dotSse2(pA, pB, n);
+#else
+	return dotScalar(pA, pB, n);
+#endif
+}
+
+inline int32_t minMaxValues(const int32_t* pData, std::size_t n, bool isMax) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return minMaxAvx2(pData, n, isMax);
+	}
+#if lia_SIMD_SSE2
+	return minMaxSse2(pData, n, isMax);
+#else
+	return isMax ? maxScalar(pData, n) : minScalar(pData, n);
+#endif
+}
+
+inline float minMaxValues(const float* pData, std::size_t n, bool isMax) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return minMaxAvx2(pData, n, isMax);
+	}
+#if lia_SIMD_SSE2
+	return minMaxSse2(pData, n, isMax);
+#else
+	return isMax ? maxScalar(pData, n) : minScalar(pData, n);
+#endif
+}
+
+inline double minMaxValues(const double* pData, std::size_t n, bool isMax) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return minMaxAvx2(pData, n, isMax);
+	}
+#if lia_SIMD_SSE2
+	return minMaxSse2(pData, n, isMax);
+#else
+	return isMax ? maxScalar(pData, n) : minScalar(pData, n);
+#endif
+}
+
+inline std::size_t argMinMaxValues(const int32_t* pData, std::size_t n, bool isMax) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return argMinMaxChunked(pData, n, isMax, &argMinMaxAvx2);
+	}
+#if lia_SIMD_SSE2
+	return argMinMaxChunked(pData, n, isMax, &argMinMaxSse2);
+#else
+	return argMinMaxScalar(pData, n, isMax);
+#endif
+}
+
+inline std::size_t argMinMaxValues(const float* pData, std::size_t n, bool isMax) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return argMinMaxChunked(pData, n, isMax, &argMinMaxAvx2);
+	}
+#if lia_SIMD_SSE2
+	return argMinMaxChunked(pData, n, isMax, &argMinMaxSse2);
+#else
+	return argMinMaxScalar(pData, n, isMax);
+#endif
+}
+
+inline std::size_t argMinMaxValues(const double* pData, std::size_t n, bool isMax) {
+	if (getSimdLevel() >= kSimdAvx2) {
+		return argMinMaxAvx2(pData, n, isMax);
+	}
+#if lia_SIMD_SSE2
+	return argMinMaxSse2(pData, n, isMax);
+#else
+	return argMinMaxScalar(pData, n, isMax);
+#endif
+}
+
+#endif
+
+// Runs a kReduce... operation on the n elements at pData, and for kReduceDot the n elements at pOther. pResult points
+// to a ReduceTypes<U>::Sum for kReduceSum and kReduceDot, to a U for kReduceMin and kReduceMax, and to an abi_size_t
+// receiving the offset from pData for kReduceArgMin and kReduceArgMax. Returns false for invalid arguments.
+template<bool isReducible>
+struct ReduceRange {
+	template<typename U>
+	static bool reduce(const U* pData, std::size_t n, uint32_t operation, const U* pOther, void* pResult) {
+		typedef typename RemoveConst<U>::type TValue;
+		typedef typename ReduceTypes<TValue>::Sum TSum;
+		switch (operation) {
+			case kReduceSum:
+				*static_cast<TSum*>(pResult) = (n > 0u) ? sumValues(pData, n) : TSum(0);
+				return true;
+			case kReduceDot:
+				if (pOther == lia_NULLPTR) {
+					return false;
+				}
+				*static_cast<TSum*>(pResult) = (n > 0u) ? dotValues(pData, pOther, n) : TSum(0);
+				return true;
+			case kReduceMin:
+			case kReduceMax:
+				if (n == 0u) {
+					return false;
+				}
+				*static_cast<TValue*>(pResult) = minMaxValues(pData, n, (operation == kReduceMax));
+				return true;
+			case kReduceArgMin:
+			case kReduceArgMax:
+				*static_cast<abi_size_t*>(pResult) = static_cast<abi_size_t>(argMinMaxValues(pData, n, (operation == kReduceArgMax)));
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	// Counts the elements in numBins bins of equal width over [lower, upper). Elements outside aren't counted.
+	template<typename U>
+	static bool histogram(const U* pData, std::size_t n, double lower, double upper, std::size_t numBins, abi_size_t* pCounts) {
+		if ((numBins == 0u) || !(lower < upper) || (pCounts == lia_NULLPTR)) {
+			return false;
+		}
+		for (std::size_t i=0; i<numBins; ++i) {
+			pCounts[i] = 0u;
+		}
+		const double scale = static_cast<double>(numBins) / (upper - lower);
+		for (std::size_t i=0; i<n; ++i) {
+			const double value = static_cast<double>(pData[i]);
+			if ((value >= lower) && (value < upper)) {
+				const std::size_t bin = static_cast<std::size_t>((value - lower) * scale);
+				++pCounts[(bin < numBins) ? bin : (numBins - 1u)];
+			}
+		}
+		return true;
+	}
+
+	// Like reduce() and histogram(), for the elements [idx, idx+n) of a native container of the owning module
+	template<typename TContainer, typename U>
+	static bool reduceAt(const TContainer& container, std::size_t idx, std::size_t n, uint32_t operation, const U* pOther, void* pResult) {
+		return reduce((n > 0u) ? &container[idx] : lia_NULLPTR, n, operation, pOther, pResult);
+	}
+
+	template<typename TContainer>
+	static bool histogramAt(const TContainer& container, std::size_t idx, std::size_t n, double lower, double upper, std::size_t numBins, abi_size_t* pCounts) {
+		return histogram((n > 0u) ? &container[idx] : lia_NULLPTR, n, lower, upper, numBins, pCounts);
+	}
+};
+
+template<>
+struct ReduceRange<false> {
+	template<typename TContainer, typename U>
+	static bool reduceAt(const TContainer&, std::size_t, std::size_t, uint32_t, const U*, void*) {
+		return false;
+	}
+
+	template<typename TContainer>
+	static bool histogramAt(const TContainer&, std::size_t, std::size_t, double, double, std::size_t, abi_size_t*) {
+		return false;
+	}
+};
+
+}
+}
+
+#endif
+
+#include <lia/detail/PopWarnings.h>
+
+#endif
@@ -0,0 +1,150 @@
+/*
++-----------------------------------+
+|                                   |
+|                 A                 |
+|                A A                |
+|               A   A               |
+|              A     A              |
+|  #  AAAAAAAAAAAAAAAAAAAAAAAAA  #  |
+|  ###       A         A       ###  |
+|  ######   A           A    #####  |
+|  ####### A             A #######  |
+|                                   |
++-----------------------------------+
+
+L I B A C R O S S - Using C++ containers
+ across DLL- and ABI-stable boundaries
+
+If you like this project, please refer to it with a link or
+some other reference. You can use this ASCII art icon as well
+as the supplied graphical icons for that purpose.
+
+(c) Copyright 2019 Jens Ganter-Benzing
+
+Licensed under the MIT license:
+
+http://www.opensource.org/licenses/mit-license.php
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#ifndef lia_detail_Remove_h_INCLUDED
+#define lia_detail_Remove_h_INCLUDED
+
+#ifdef __cplusplus
+	#include <cstddef>
+#endif
+#include <lia/defs.h>
+#include <lia/detail/Search.h>
+#if defined(__cplusplus) && lia_CPP11_API
+	#include <utility>
+#endif
+
+#include <lia/detail/PushWarnings.h>
+
+#ifdef __cplusplus
+
+namespace lia {
+namespace detail {
+
+// Moves the elements [first, last) of container that remove(index) is false for to the front of that range, keeping
+// their order, and returns the index after the last of them. Each element is moved at most once, so this is O(n)
+// however many elements are removed. The elements from the returned index to last are left in a valid but
+// unspecified state and are erased by the caller.
+template<typename TContainer, typename TRemove>
+std::size_t compactIndices(TContainer& container, std::size_t first, std::size_t last, TRemove remove) {
+	std::size_t dst = first;
+	for (std::size_t src=first; src<last; ++src) {
+		if (!remove(src)) {
+			if (dst != src) {
+#if lia_CPP11_API
+				container[dst] = std::move(container[src]);
+#else
+				container[dst] = container[src];
+#endif
+			}
+			++dst;
+		}
+	}
+	return dst;
+}
+
+// Comparison with operator==, which is used when no predicate for equality is given
+struct DefaultEqual {
+	template<typename U>
+	bool operator()(const U& a, const U& b) const {
+		return a == b;
+	}
+};
+
+// Whether the element at an index of a lia interface is equal to the one before it, with the elements being fetched
+// over the ABI boundary. Used for removing duplicates in implementations that can't remove them themselves.
+template<typename TInterface, typename TEqual>
+class EqualToPrevious {
+public:
+
+	EqualToPrevious(const TInterface& container, TEqual equal): m_container(container), m_equal(equal) {}
+
+	bool operator()(std::size_t i) const {
+		typename TInterface::const_pointer pPrevious;
+		typename TInterface::const_pointer pElem;
+		if (i == 0u) {
+			return false;
+		}
+		if (!m_container.abiGetAtConst(static_cast<abi_size_t>(i - 1u), pPrevious) || !m_container.abiGetAtConst(static_cast<abi_size_t>(i), pElem)) {
+			lia_THROW1(std::out_of_range, "in unique() call");
+		}
+		return m_equal(pPrevious, pElem);
+	}
+
+private:
+	const TInterface& m_container;
+	TEqual            m_equal;
+};
+
+// Whether a mask of maskSize bytes in format kMaskBytes or kMaskBits covers n elements
+inline bool coversElements(std::size_t maskSize, uint32_t maskFormat, std::size_t n) lia_NOEXCEPT {
+	return maskSize >= ((maskFormat == kMaskBits) ? ((n / 8u) + (((n % 8u) != 0u) ? 1u : 0u)) : n);
+}
+
+// Whether the element at an index isn't selected by a mask of format kMaskBytes or kMaskBits
+class MaskedOut {
+public:
+
+	MaskedOut(const uint8_t* pMask, uint32_t maskFormat): m_pMask(pMask), m_isBits(maskFormat == kMaskBits) {}
+
+	bool operator()(std::size_t i) const {
+		if (m_isBits) {
+			return ((m_pMask[i / 8u] >> (i % 8u)) & 1u) == 0u;
+		}
+		return m_pMask[i] == 0u;
+	}
+
+private:
+	const uint8_t* m_pMask;
+	bool           m_isBits;
+};
+
+}
+}
+
+#endif
+
+#include <lia/detail/PopWarnings.h>
+
+#endif
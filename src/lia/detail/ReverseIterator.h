@@ -55,11 +55,31 @@ THE SOFTWARE.
 #ifdef __cplusplus
 
 namespace lia {
+
+template<typename T>
+class VectorIteratorHandle;
+
 namespace detail {
 
+// Tag for constructing a ReverseIterator from an iterator that already iterates backwards natively
+struct NativeReverse {};
+
+// Returns the forward iterator that a natively reversed iterator is based on. Only iterator types which
+// support native reverse iteration have an overload for it.
+template<typename TIter>
+TIter getReverseBase(const TIter& iter) {
+	return iter;
+}
+
+template<typename T>
+lia::VectorIteratorHandle<T> getReverseBase(const lia::VectorIteratorHandle<T>& iter);
+
 // Re-implementation of std::reverse_iterator, needed because the proxy objects (for example lia::detail::VectorProxy) act different
 // to pointers and so some functions, such as reverse_iterator::operator->, don't work on all platforms/tool chains.
 // This implementation is aware of the specialities of libacross, so this one is used instead of std::reverse_iterator for several r[c]begin()/r[c]end() implementations.
+// Besides wrapping a forward iterator like std::reverse_iterator, it can wrap an iterator that iterates backwards natively
+// (see NativeReverse). The wrapped iterator then points to the element itself, so dereferencing it doesn't need a temporary
+// copy of the iterator.
 template<typename TIter>
 class ReverseIterator
 {
@@ -76,89 +96,125 @@ public:
 	typedef typename std::iterator_traits<TIter>::pointer            pointer;
 	typedef typename std::iterator_traits<TIter>::reference          reference;
 
-	ReverseIterator() {}
+	ReverseIterator(): m_isNative(false) {}
 
-	explicit ReverseIterator(TIter iter): m_impl(iter) {}
-
-	template<class U>
-	ReverseIterator(const ReverseIterator<U>& iter): m_impl(iter) {}
+	explicit ReverseIterator(TIter iter): m_impl(iter), m_isNative(false) {}
 
-	template<class U>
+	ReverseIterator(TIter nativeReverseIter, NativeReverse): m_impl(nativeReverseIter), m_isNative(true) {}
+
+	template<class U>
+	ReverseIterator(const ReverseIterator<U>& iter): m_impl(iter.m_impl), m_isNative(iter.m_isNative) {}
+
+	template<class U>
 	ThisType& operator=(const ReverseIterator<U>& other) {
-		m_impl = other.m_impl;
+		m_impl     = other.m_impl;
+		m_isNative = other.m_isNative;
 		return *this;
 	}
 
 	TIter base() const {
-		return m_impl;
+		return m_isNative ? getReverseBase(m_impl) : m_impl;
 	}
 
-	reference operator*() const {
-		TIter tmp = m_impl;
-		(void)--tmp;
-		return *tmp;
+	reference operator*() const {
+		if (m_isNative) {
+			return *m_impl;
+		}
+		TIter tmp = m_impl;
+		(void)--tmp;
+		return *tmp;
 	}
 
-	pointer operator->() const {
-		TIter tmp = m_impl;
-		(void)--tmp;
-		return tmp.operator->();
+	pointer operator->() const {
+		if (m_isNative) {
+			return m_impl.operator->();
+		}
+		TIter tmp = m_impl;
+		(void)--tmp;
+		return tmp.operator->();
 	}
 
 	ReverseIterator& operator++() {
-		(void)--m_impl;
+		step(1);
 		return *this;
 	}
 
-	ReverseIterator& operator++(int) {
+	ThisType operator++(int) {
 		ThisType tmp = *this;
-		(void)--m_impl;
+		step(1);
 		return tmp;
 	}
 
 	ReverseIterator& operator--() {
-		(void)++m_impl;
+		step(-1);
 		return *this;
 	}
 
-	ReverseIterator& operator--(int) {
+	ThisType operator--(int) {
 		ThisType tmp = *this;
-		(void)++m_impl;
+		step(-1);
 		return tmp;
 	}
 
 	bool operator==(const ThisType& other) const {
-		return m_impl == other.m_impl;
+		if (m_isNative == other.m_isNative) {
+			return m_impl == other.m_impl;
+		}
+		return base() == other.base();
 	}
 
 	bool operator!=(const ThisType& other) const {
-		return m_impl != other.m_impl;
-	}
-
-	ThisType& operator+=(difference_type i) {
-		m_impl -= i;
-		return *this;
-	}
-
-	ThisType operator+(difference_type i) const {
-		return (ThisType(m_impl - i));
-	}
-
-	ThisType& operator-=(difference_type i) {
-		m_impl += i;
-		return *this;
-	}
-
-	ThisType operator-(difference_type i) const {
-		return (ThisType(m_impl + i));
-	}
-
-	reference operator[](difference_type i) const {
-		return (*(*this + i));
-	}
+		return !(*this == other);
+	}
+
+	difference_type operator-(const ThisType& other) const {
+		if (m_isNative && other.m_isNative) {
+			return m_impl - other.m_impl;
+		}
+		return other.base() - base();
+	}
+
+	ThisType& operator+=(difference_type i) {
+		step(i);
+		return *this;
+	}
+
+	ThisType operator+(difference_type i) const {
+		ThisType result = *this;
+		result.step(i);
+		return result;
+	}
+
+	ThisType& operator-=(difference_type i) {
+		step(-i);
+		return *this;
+	}
+
+	ThisType operator-(difference_type i) const {
+		ThisType result = *this;
+		result.step(-i);
+		return result;
+	}
+
+	reference operator[](difference_type i) const {
+		return (*(*this + i));
+	}
 
 private:
+	template<typename U>
+	friend class ReverseIterator;
+
+	void step(difference_type i) {
+		if (m_isNative) {
+			m_impl += i;
+		}
+		else {
+			m_impl -= i;
+		}
+	}
+
 	TIter m_impl;
+	bool  m_isNative;
 };
 
 }
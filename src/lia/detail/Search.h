@@ -0,0 +1,348 @@
+/*
++-----------------------------------+
+|                                   |
+|                 A                 |
+|                A A                |
+|               A   A               |
+|              A     A              |
+|  #  AAAAAAAAAAAAAAAAAAAAAAAAA  #  |
+|  ###       A         A       ###  |
+|  ######   A           A    #####  |
+|  ####### A             A #######  |
+|                                   |
++-----------------------------------+
+
+L I B A C R O S S - Using C++ containers
+ across DLL- and ABI-stable boundaries
+
+If you like this project, please refer to it with a link or
+some other reference. You can use this ASCII art icon as well
+as the supplied graphical icons for that purpose.
+
+(c) Copyright 2019 Jens Ganter-Benzing
+
+Licensed under the MIT license:
+
+http://www.opensource.org/licenses/mit-license.php
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#ifndef lia_detail_Search_h_INCLUDED
+#define lia_detail_Search_h_INCLUDED
+
+#ifdef __cplusplus
+	#include <algorithm>
+	#include <cstddef>
+	#include <stdexcept>
+#endif
+#include <lia/defs.h>
+#include <lia/detail/Sort.h>
+
+#include <lia/detail/PushWarnings.h>
+
+#ifdef __cplusplus
+
+namespace lia {
+namespace detail {
+
+// Type of the values that elements of type T are searched for. Elements of lia interface types are compared with
+// the native containers passed by the caller, like std::vector for vectors of vectors.
+template<typename T, typename U>
+struct SearchValue {
+	typedef typename IfThenElse<IsLiaInterface<typename RemoveConst<T>::type>::value, U, typename RemoveConst<T>::type>::type Type;
+};
+
+// Counts the elements equal to value. The loop has no early exit, so that compilers vectorize it for arithmetic types.
+template<typename U>
+std::size_t countValue(const U* pData, std::size_t n, const U& value) {
+	std::size_t result = 0u;
+	for (std::size_t i=0; i<n; ++i) {
+		result += (pData[i] == value) ? 1u : 0u;
+	}
+	return result;
+}
+
+// Returns the offset of the first element equal to value, or n if there's none. For arithmetic types, blocks of
+// elements are compared without early exit, so that compilers vectorize the comparisons, and only the block
+// containing a match is searched element by element.
+template<typename U>
+std::size_t findValue(const U* pData, std::size_t n, const U& value) {
+	std::size_t i = 0u;
+	if (IsArithmetic<U>::value) {
+		const std::size_t kBlockSize = (sizeof(U) < 4u) ? 64u : (256u / sizeof(U));
+		for (; (n - i) >= kBlockSize; i += kBlockSize) {
+			unsigned int found = 0u;
+			for (std::size_t j=0; j<kBlockSize; ++j) {
+				found |= (pData[i + j] == value) ? 1u : 0u;
+			}
+			if (found != 0u) {
+				break;
+			}
+		}
+	}
+	for (; i<n; ++i) {
+		if (pData[i] == value) {
+			return i;
+		}
+	}
+	return n;
+}
+
+// Returns the index of the first element in [first, last) that pred(index) is false for, where pred is true
+// for all elements before and false for all elements after it, like std::partition_point
+template<typename TPred>
+std::size_t partitionPoint(std::size_t first, std::size_t last, TPred pred) {
+	std::size_t n = last - first;
+	while (n > 0u) {
+		const std::size_t half = n / 2u;
+		if (pred(first + half)) {
+			first += half + 1u;
+			n     -= half + 1u;
+		}
+		else {
+			n = half;
+		}
+	}
+	return first;
+}
+
+// Returns the index of the first element in [first, last) that pred(index) is true for, or last if there's none.
+// Returns the number of those elements for kSearchCount.
+template<typename TPred>
+std::size_t scanIndices(std::size_t first, std::size_t last, uint32_t algorithm, TPred pred) {
+	std::size_t result = 0u;
+	for (std::size_t i=first; i<last; ++i) {
+		if (pred(i)) {
+			if (algorithm == kSearchFind) {
+				return i;
+			}
+			++result;
+		}
+	}
+	return (algorithm == kSearchFind) ? last : result;
+}
+
+// Writes the result of kSearchLowerBound, kSearchUpperBound or kSearchEqualRange on [first, last) to pResult.
+// isBefore(index) is true if the element is less than the value searched for, isNotAfter(index) if it isn't greater.
+template<typename TIsBefore, typename TIsNotAfter>
+void searchBounds(std::size_t first, std::size_t last, uint32_t algorithm, TIsBefore isBefore, TIsNotAfter isNotAfter, abi_size_t* pResult) {
+	if (algorithm == kSearchUpperBound) {
+		pResult[0] = static_cast<abi_size_t>(partitionPoint(first, last, isNotAfter));
+		return;
+	}
+	const std::size_t lower = partitionPoint(first, last, isBefore);
+	pResult[0] = static_cast<abi_size_t>(lower);
+	if (algorithm == kSearchEqualRange) {
+		pResult[1] = static_cast<abi_size_t>(partitionPoint(lower, last, isNotAfter));
+	}
+}
+
+// Comparison of elements and values that are both accessed through element pointers. Elements of containers of
+// containers are accessed through proxies then, and compared with the operators of their lia interfaces.
+template<typename T>
+struct PointerLess {
+	bool operator()(typename MakeTypes<T>::ConstPointer& pA, typename MakeTypes<T>::ConstPointer& pB) const {
+		return derefElemPtr(pA) < derefElemPtr(pB);
+	}
+};
+
+template<typename T>
+struct PointerEqual {
+	bool operator()(typename MakeTypes<T>::ConstPointer& pA, typename MakeTypes<T>::ConstPointer& pB) const {
+		return derefElemPtr(pA) == derefElemPtr(pB);
+	}
+};
+
+// Calls a comparator callback of type CompareTypes<T>::Function with element pointers
+template<typename T>
+class CallbackPointerCompare {
+public:
+
+	CallbackPointerCompare(typename CompareTypes<T>::Function pFunc, void* pContext): m_pFunc(pFunc), m_pContext(pContext) {}
+
+	bool operator()(typename MakeTypes<T>::ConstPointer& pA, typename MakeTypes<T>::ConstPointer& pB) const {
+		const int32_t result = (*m_pFunc)(m_pContext, pA, pB);
+		if (result < 0) {
+			lia_THROW0(CallbackAborted);
+		}
+		return (result > 0);
+	}
+
+private:
+	typename CompareTypes<T>::Function m_pFunc;
+	void*                              m_pContext;
+};
+
+// Calls a predicate callback of type PredicateTypes<T>::Function with element pointers
+template<typename T>
+class CallbackPredicate {
+public:
+
+	CallbackPredicate(typename PredicateTypes<T>::Function pFunc, void* pContext): m_pFunc(pFunc), m_pContext(pContext) {}
+
+	bool operator()(typename MakeTypes<T>::ConstPointer& pElem) const {
+		const int32_t result = (*m_pFunc)(m_pContext, pElem);
+		if (result < 0) {
+			lia_THROW0(CallbackAborted);
+		}
+		return (result > 0);
+	}
+
+private:
+	typename PredicateTypes<T>::Function m_pFunc;
+	void*                                m_pContext;
+};
+
+// Predicates on element pointers that compare the element with a value
+template<typename T>
+class EqualsValue {
+public:
+
+	explicit EqualsValue(typename MakeTypes<T>::ConstPointer& pValue): m_pValue(pValue) {}
+
+	bool operator()(typename MakeTypes<T>::ConstPointer& pElem) const {
+		return derefElemPtr(pElem) == derefElemPtr(m_pValue);
+	}
+
+private:
+	typename MakeTypes<T>::ConstPointer& m_pValue;
+};
+
+template<typename T, typename TLess>
+class IsBeforeValue {
+public:
+
+	IsBeforeValue(typename MakeTypes<T>::ConstPointer& pValue, TLess& less): m_pValue(pValue), m_less(less) {}
+
+	bool operator()(typename MakeTypes<T>::ConstPointer& pElem) const {
+		return m_less(pElem, m_pValue);
+	}
+
+private:
+	typename MakeTypes<T>::ConstPointer& m_pValue;
+	TLess&                               m_less;
+};
+
+template<typename T, typename TLess>
+class IsNotAfterValue {
+public:
+
+	IsNotAfterValue(typename MakeTypes<T>::ConstPointer& pValue, TLess& less): m_pValue(pValue), m_less(less) {}
+
+	bool operator()(typename MakeTypes<T>::ConstPointer& pElem) const {
+		return !m_less(m_pValue, pElem);
+	}
+
+private:
+	typename MakeTypes<T>::ConstPointer& m_pValue;
+	TLess&                               m_less;
+};
+
+// Applies a predicate on element pointers to the element at an index of a native container of the owning module
+template<typename T, typename TContainer, typename TPred>
+class ElementAt {
+public:
+
+	ElementAt(const TContainer& container, TPred pred): m_container(container), m_pred(pred) {}
+
+	bool operator()(std::size_t i) const {
+		typename MakeTypes<T>::ConstPointer pElem;
+		assignElemPtr(pElem, m_container[i]);
+		return m_pred(pElem);
+	}
+
+private:
+	const TContainer& m_container;
+	TPred             m_pred;
+};
+
+template<typename T, typename TContainer, typename TPred>
+ElementAt<T, TContainer, TPred> elementAt(const TContainer& container, TPred pred) {
+	return ElementAt<T, TContainer, TPred>(container, pred);
+}
+
+// Adapts a comparator of the caller's module, which takes elements, to element pointers
+template<typename T, typename TLess>
+class DerefLess {
+public:
+
+	explicit DerefLess(TLess& less): m_less(less) {}
+
+	bool operator()(typename MakeTypes<T>::ConstPointer& pA, typename MakeTypes<T>::ConstPointer& pB) const {
+		return m_less(derefElemPtr(pA), derefElemPtr(pB));
+	}
+
+private:
+	TLess& m_less;
+};
+
+// Applies a predicate on element pointers to the element at an index of a lia interface, which is fetched over
+// the ABI boundary. Used for binary searches in implementations that can't search themselves.
+template<typename TInterface, typename TPred>
+class ElementOf {
+public:
+
+	ElementOf(const TInterface& container, TPred pred): m_container(container), m_pred(pred) {}
+
+	bool operator()(std::size_t i) const {
+		typename TInterface::const_pointer pElem;
+		if (!m_container.abiGetAtConst(static_cast<abi_size_t>(i), pElem)) {
+			lia_THROW1(std::out_of_range, "in search");
+		}
+		return m_pred(pElem);
+	}
+
+private:
+	const TInterface& m_container;
+	TPred             m_pred;
+};
+
+// Runs kSearchFind or kSearchCount for a value. Elements of types other than lia interfaces are compared in their
+// contiguous storage with the loops above, others through element pointers.
+template<bool isContiguous>
+struct ScanForValue {
+	template<typename T, typename TContainer>
+	static std::size_t scan(const TContainer& container, std::size_t first, std::size_t last, uint32_t algorithm, typename MakeTypes<T>::ConstPointer& pValue) {
+		if (first >= last) {
+			return (algorithm == kSearchFind) ? last : 0u;
+		}
+		const typename TContainer::value_type* pData = &container[first];
+		if (algorithm == kSearchFind) {
+			return first + findValue(pData, last - first, *pValue);
+		}
+		return countValue(pData, last - first, *pValue);
+	}
+};
+
+template<>
+struct ScanForValue<false> {
+	template<typename T, typename TContainer>
+	static std::size_t scan(const TContainer& container, std::size_t first, std::size_t last, uint32_t algorithm, typename MakeTypes<T>::ConstPointer& pValue) {
+		return scanIndices(first, last, algorithm, elementAt<T>(container, EqualsValue<T>(pValue)));
+	}
+};
+
+}
+}
+
+#endif
+
+#include <lia/detail/PopWarnings.h>
+
+#endif
@@ -0,0 +1,208 @@
+/*
++-----------------------------------+
+|                                   |
+|                 A                 |
+|                A A                |
+|               A   A               |
+|              A     A              |
+|  #  AAAAAAAAAAAAAAAAAAAAAAAAA  #  |
+|  ###       A         A       ###  |
+|  ######   A           A    #####  |
+|  ####### A             A #######  |
+|                                   |
++-----------------------------------+
+
+L I B A C R O S S - Using C++ containers
+ across DLL- and ABI-stable boundaries
+
+If you like this project, please refer to it with a link or
+some other reference. You can use this ASCII art icon as well
+as the supplied graphical icons for that purpose.
+
+(c) Copyright 2019 Jens Ganter-Benzing
+
+Licensed under the MIT license:
+
+http://www.opensource.org/licenses/mit-license.php
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#ifndef lia_detail_Sort_h_INCLUDED
+#define lia_detail_Sort_h_INCLUDED
+
+#ifdef __cplusplus
+	#include <algorithm>
+	#include <cstddef>
+	#include <exception>
+	#include <vector>
+#endif
+#include <lia/defs.h>
+#if defined(__cplusplus) && lia_CPP11_API
+	#include <thread>
+#endif
+
+#include <lia/detail/PushWarnings.h>
+
+#ifdef __cplusplus
+
+namespace lia {
+namespace detail {
+
+// Comparison with operator<, which is used when no comparator is given
+struct DefaultLess {
+	template<typename U>
+	bool operator()(const U& a, const U& b) const {
+		return a < b;
+	}
+};
+
+// Thrown inside the owning module to abort an algorithm when a callback into the caller's module failed
+struct CallbackAborted {};
+
+// Calls a comparator callback of type CompareTypes<T>::Function with pointers to the elements of the owning module
+template<typename T>
+class CallbackCompare {
+public:
+
+	CallbackCompare(typename CompareTypes<T>::Function pFunc, void* pContext): m_pFunc(pFunc), m_pContext(pContext) {}
+
+	template<typename U>
+	bool operator()(const U& a, const U& b) const {
+		typename MakeTypes<T>::ConstPointer pA;
+		typename MakeTypes<T>::ConstPointer pB;
+		assignElemPtr(pA, a);
+		assignElemPtr(pB, b);
+		const int32_t result = (*m_pFunc)(m_pContext, pA, pB);
+		if (result < 0) {
+			lia_THROW0(CallbackAborted);
+		}
+		return (result > 0);
+	}
+
+private:
+	typename CompareTypes<T>::Function m_pFunc;
+	void*                              m_pContext;
+};
+
+#if lia_CPP11_API
+
+const std::size_t kMinParallelSortSize = 16384u; // smaller parts aren't worth a thread of their own
+
+// Calls func(i) for all i in [0, n), i > 0 on threads of their own. Exceptions are rethrown when all threads are finished.
+template<typename TFunc>
+void runInParallel(std::size_t n, TFunc func) {
+	std::vector<std::exception_ptr> errors(n);
+	std::vector<std::thread> threads;
+	threads.reserve(n);
+	lia_TRY
+		for (std::size_t i=1; i<n; ++i) {
+			threads.push_back(std::thread([&func, &errors, i]() {
+				lia_TRY
+					func(i);
+				lia_CATCHALL(errors[i] = std::current_exception())
+			}));
+		}
+		func(0);
+	lia_CATCHALL(errors[0] = std::current_exception())
+	for (std::size_t i=0; i<threads.size(); ++i) {
+		threads[i].join();
+	}
+	for (std::size_t i=0; i<n; ++i) {
+		if (errors[i]) {
+			std::rethrow_exception(errors[i]);
+		}
+	}
+}
+
+// Sorts numThreads parts of [first, last) concurrently, and merges neighboring parts afterwards, also concurrently
+template<typename TIter, typename TLess>
+void sortInParallel(TIter first, TIter last, TLess less, std::size_t numThreads, bool isStable) {
+	const std::size_t n = static_cast<std::size_t>(last - first);
+	const std::size_t numParts = std::min(numThreads, n / kMinParallelSortSize);
+	if (numParts < 2u) {
+		if (isStable) {
+			std::stable_sort(first, last, less);
+		}
+		else {
+			std::sort(first, last, less);
+		}
+		return;
+	}
+	std::vector<TIter> bounds(numParts + 1u);
+	for (std::size_t i=0; i<=numParts; ++i) {
+		bounds[i] = first + static_cast<std::ptrdiff_t>((n / numParts) * i + ((n % numParts) * i) / numParts);
+	}
+	runInParallel(numParts, [&](std::size_t i) {
+		if (isStable) {
+			std::stable_sort(bounds[i], bounds[i + 1u], less);
+		}
+		else {
+			std::sort(bounds[i], bounds[i + 1u], less);
+		}
+	});
+	for (std::size_t width=1; width<numParts; width *= 2u) {
+		const std::size_t numMerges = (numParts - width + 2u * width - 1u) / (2u * width);
+		runInParallel(numMerges, [&](std::size_t m) {
+			const std::size_t i = m * 2u * width;
+			std::inplace_merge(bounds[i], bounds[i + width], bounds[std::min(i + 2u * width, numParts)], less);
+		});
+	}
+}
+
+#endif
+
+// Runs one of the kSort... algorithms on [first, last). Only kSortUnstable and kSortStable use more than one thread.
+template<typename TIter, typename TLess>
+void runSortAlgorithm(TIter first, TIter last, uint32_t algorithm, std::size_t middle, TLess less, std::size_t numThreads) {
+	switch (algorithm) {
+		case kSortUnstable:
+		case kSortStable:
+#if lia_CPP11_API
+			sortInParallel(first, last, less, numThreads, (algorithm == kSortStable));
+#else
+			(void)numThreads;
+			if (algorithm == kSortStable) {
+				std::stable_sort(first, last, less);
+			}
+			else {
+				std::sort(first, last, less);
+			}
+#endif
+			break;
+		case kSortPartial:
+			std::partial_sort(first, first + static_cast<std::ptrdiff_t>(middle), last, less);
+			break;
+		case kSortNthElement:
+			if (middle < static_cast<std::size_t>(last - first)) {
+				std::nth_element(first, first + static_cast<std::ptrdiff_t>(middle), last, less);
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+}
+}
+
+#endif
+
+#include <lia/detail/PopWarnings.h>
+
+#endif
@@ -47,6 +47,11 @@ THE SOFTWARE.
 #define lia_detail_VectorApiMixin_h_INCLUDED
 
 #ifdef __cplusplus
+	#include <algorithm>
+	#include <cstring>
+	#include <exception>
+	#include <functional>
+	#include <iterator>
 	#include <new>
 	#include <stdexcept>
 	#include <vector>
@@ -54,13 +59,32 @@ THE SOFTWARE.
 #endif
 #include <lia/defs.h>
 #include <lia/detail/ReverseIterator.h>
+#include <lia/detail/Gather.h>
+#include <lia/detail/Reduce.h>
+#include <lia/detail/Remove.h>
+#include <lia/detail/Search.h>
+#include <lia/detail/Sort.h>
+#if defined(__cplusplus) && lia_CPP11_API
+	#include <mutex>
+	#include <thread>
+#endif
 #include <lia/detail/PushWarnings.h>
 
 #ifdef __cplusplus
 
 namespace lia {
+
+template<typename T>
+class VectorIndexIterator;
+
+template<typename T>
+class VectorView;
+
 namespace detail {
 
+template<typename T>
+class VectorProxy;
+
 // Mix-in class for adding public RandomAccessIterator API into sub-class.
 template<typename T,
          typename TSubClass,
@@ -182,6 +206,141 @@ private:
 
 lia_STATIC_ASSERT(sizeof(VectorIteratorApiMixin<int, int, int, int&, int*>) == 1u, "API class is not allowed to contain any virtual functions")
 
+// Context of a visitor callback: Calls func(chunk, n) of the caller's module from inside the module owning the
+// container. Exceptions thrown by func are caught before they reach the owning module and rethrown afterwards.
+template<typename TFunc>
+class VisitContext {
+public:
+
+	explicit VisitContext(TFunc& func): m_func(func), m_hasFailed(false) {}
+
+	template<typename TChunk>
+	static abi_bool_t lia_CALL call(void* pContext, TChunk pElems, abi_size_t n) lia_NOEXCEPT {
+		VisitContext& rThis = *static_cast<VisitContext*>(pContext);
+		lia_TRY
+			return rThis.m_func(pElems, static_cast<std::size_t>(n)) ? abi_true : abi_false;
+		lia_CATCHALL(rThis.storeException(); return abi_false)
+	}
+
+	void rethrowIfFailed() {
+		if (m_hasFailed) {
+#if lia_CPP11_API
+			std::rethrow_exception(m_exception);
+#else
+			lia_THROW1(std::runtime_error, "in visitor callback");
+#endif
+		}
+	}
+
+private:
+	VisitContext(const VisitContext&);
+	VisitContext& operator=(const VisitContext&);
+
+	void storeException() lia_NOEXCEPT {
+		m_hasFailed = true;
+#if lia_CPP11_API
+		m_exception = std::current_exception();
+#endif
+	}
+
+	TFunc& m_func;
+	bool   m_hasFailed;
+#if lia_CPP11_API
+	std::exception_ptr m_exception;
+#endif
+};
+
+// Context of a comparator or predicate callback: Calls func(a, b) or func(a) of the caller's module from inside the
+// module owning the container. Like for VisitContext, exceptions thrown by func are rethrown after the call over the
+// ABI boundary. The owning module may call back on several threads at once, so storing the exception is synchronized.
+template<typename TFunc>
+class CallbackContext {
+public:
+
+	explicit CallbackContext(TFunc& func): m_func(func), m_hasFailed(false) {}
+
+	template<typename TConstPointer>
+	static int32_t lia_CALL compare(void* pContext, TConstPointer& pA, TConstPointer& pB) lia_NOEXCEPT {
+		CallbackContext& rThis = *static_cast<CallbackContext*>(pContext);
+		lia_TRY
+			return rThis.m_func(derefElemPtr(pA), derefElemPtr(pB)) ? 1 : 0;
+		lia_CATCHALL(rThis.storeException(); return -1)
+	}
+
+	template<typename TConstPointer>
+	static int32_t lia_CALL test(void* pContext, TConstPointer& pElem) lia_NOEXCEPT {
+		CallbackContext& rThis = *static_cast<CallbackContext*>(pContext);
+		lia_TRY
+			return rThis.m_func(derefElemPtr(pElem)) ? 1 : 0;
+		lia_CATCHALL(rThis.storeException(); return -1)
+	}
+
+	void rethrowIfFailed() {
+		if (m_hasFailed) {
+#if lia_CPP11_API
+			std::rethrow_exception(m_exception);
+#else
+			lia_THROW1(std::runtime_error, "in comparator or predicate callback");
+#endif
+		}
+	}
+
+private:
+	CallbackContext(const CallbackContext&);
+	CallbackContext& operator=(const CallbackContext&);
+
+	void storeException() lia_NOEXCEPT {
+#if lia_CPP11_API
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_hasFailed) {
+			m_exception = std::current_exception();
+		}
+#endif
+		m_hasFailed = true;
+	}
+
+	TFunc& m_func;
+	bool   m_hasFailed;
+#if lia_CPP11_API
+	std::mutex         m_mutex;
+	std::exception_ptr m_exception;
+#endif
+};
+
+// Adapts a function taking single elements to a chunk visitor
+template<typename TFunc>
+class ElementVisitor {
+public:
+
+	explicit ElementVisitor(TFunc& func): m_func(func) {}
+
+	template<typename TChunk>
+	bool operator()(TChunk pElems, std::size_t n) {
+		for (std::size_t i=0; i<n; ++i) {
+			m_func(derefElemPtr(pElems + i));
+		}
+		return true;
+	}
+
+private:
+	TFunc& m_func;
+};
+
+// Sums up the sizes of containers
+class FlatSizeCounter {
+public:
+
+	explicit FlatSizeCounter(std::size_t& rSize): m_rSize(rSize) {}
+
+	template<typename TContainer>
+	void operator()(const TContainer& container) {
+		m_rSize += container.size();
+	}
+
+private:
+	std::size_t& m_rSize;
+};
+
 // Mix-in class for adding public std::vector compatible API into sub-class.
 template<typename T,
          typename TSubClass,
@@ -225,18 +384,12 @@ public:
 	VectorApiMixin& operator=(const std::vector<U, V>& v) {
 		TInterface& rThis = downCast().getAbi();
 		rThis.abiClear();
-		if (!rThis.abiReserve(static_cast<abi_size_t>(v.size()))) {
-			lia_THROW0(std::bad_alloc);
+		if (!v.empty() && insertByMemcpy(rThis, 0, &v[0], static_cast<abi_size_t>(v.size()), lia::detail::BoolType<IsContiguousTag::value && lia::detail::IsSame<U, T>::value>())) {
+			return *this;
 		}
-		abi_size_t newPos = 0;
-		typename lia::detail::MakeTypes<T>::ConstPointer pElem;
-		for (typename std::vector<U, V>::const_iterator iter = v.begin(); iter != v.end(); ++iter) {
-			assignElemPtr(pElem, *iter);
-			if (!rThis.abiInsert(newPos, pElem)) {
-				rThis.abiClear();
-				lia_THROW0(std::bad_alloc);
-			}
-			++newPos;
+		if (!insertRangeImpl(0, v.begin(), v.end(), kGrowthExact)) {
+			rThis.abiClear();
+			lia_THROW0(std::bad_alloc);
 		}
 		return *this;
 	}
@@ -246,22 +399,35 @@ public:
 		if (&v != &rThis) {
 			rThis.abiClear();
 			const abi_size_t vSize = v.abiGetSize();
-			if (!rThis.abiReserve(vSize)) {
+			reserveAdditionalImpl(rThis, vSize, kGrowthExact);
+			if (!insertFromImpl(rThis, 0, v, 0, vSize)) {
+				rThis.abiClear();
 				lia_THROW0(std::bad_alloc);
 			}
-			abi_size_t newPos = 0;
-			typename lia::detail::MakeTypes<T>::ConstPointer pElem;
-			for (abi_size_t i=0; i<vSize; ++i) {
-				v.abiGetAtConst(i, pElem);
-				if (!rThis.abiInsert(i, pElem)) {
-					rThis.abiClear();
-					lia_THROW0(std::bad_alloc);
-				}
+		}
+		return *this;
+	}
+
+#if lia_CPP11_API
+
+	//! Takes over the elements of v, leaving v empty. This is done without copying the elements when both
+	//! vectors were built with the same toolchain and use the same container type (see tryNative()).
+	VectorApiMixin& operator=(TInterface&& v) {
+		TInterface& rThis = downCast().getAbi();
+		if (&v != &rThis) {
+			if (swapStorage(rThis, v)) {
+				v.abiClear();
+			}
+			else {
+				(void)(*this = static_cast<const TInterface&>(v));
+				v.abiClear();
 			}
 		}
 		return *this;
 	}
 
+#endif
+
 #if lia_CPP11_API
 
 	template<typename U>
@@ -269,19 +435,10 @@ public:
 		lia_STATIC_ASSERT((!lia::detail::IsInitializerList<U>::value), "No nested std::initializer_list support in assignment")
 		TInterface& rThis = downCast().getAbi();
 		rThis.abiClear();
-		if (!rThis.abiReserve(static_cast<abi_size_t>(v.size()))) {
+		if (!insertRangeImpl(0, v.begin(), v.end(), kGrowthExact)) {
+			rThis.abiClear();
 			lia_THROW0(std::bad_alloc);
 		}
-		abi_size_t newPos = 0;
-		typename lia::detail::MakeTypes<T>::ConstPointer pElem;
-		for (auto iter = v.begin(); iter != v.end(); ++iter) {
-			assignElemPtr(pElem, *iter);
-			if (!rThis.abiInsert(newPos, pElem)) {
-				rThis.abiClear();
-				lia_THROW0(std::bad_alloc);
-			}
-			++newPos;
-		}
 		return *this;
 	}
 
@@ -291,18 +448,12 @@ public:
 	void assign(std::size_t count, const U& value) {
 		TInterface& rThis = downCast().getAbi();
 		rThis.abiClear();
-		if (!rThis.abiReserve(static_cast<abi_size_t>(count))) {
-			lia_THROW0(std::bad_alloc);
-		}
+		reserveAdditionalImpl(rThis, static_cast<abi_size_t>(count), kGrowthExact);
 		typename lia::detail::MakeTypes<T>::ConstPointer pElem;
 		assignElemPtr(pElem, value);
-		abi_size_t newPos = 0;
-		for (std::size_t i=0; i<count; ++i) {
-			if (!rThis.abiInsert(newPos, pElem)) {
-				rThis.abiClear();
-				lia_THROW0(std::bad_alloc);
-			}
-			++newPos;
+		if (!insertFill(rThis, 0, static_cast<abi_size_t>(count), pElem)) {
+			rThis.abiClear();
+			lia_THROW0(std::bad_alloc);
 		}
 	}
 
@@ -310,15 +461,9 @@ public:
 	void assign(InputIt first, InputIt last) {
 		TInterface& rThis = downCast().getAbi();
 		rThis.abiClear();
-		typename lia::detail::MakeTypes<T>::ConstPointer pElem;
-		abi_size_t newPos = 0;
-		for (InputIt iter=first; iter != last; ++iter) {
-			assignElemPtr(pElem, *iter);
-			if (!rThis.abiInsert(newPos, pElem)) {
-				rThis.abiClear();
-				lia_THROW0(std::bad_alloc);
-			}
-			++newPos;
+		if (!insertRangeImpl(0, first, last, kGrowthExact)) {
+			rThis.abiClear();
+			lia_THROW0(std::bad_alloc);
 		}
 	}
 
@@ -397,7 +542,10 @@ public:
 	typename lia::detail::EnableIf<!lia::detail::IsLiaInterface<U>::value, U*>::type data() lia_NOEXCEPT {
 		TInterface& rThis = downCast().getAbi();
 		U* pResult;
-		if (!rThis.abiGetAt(0, pResult)) {
+		if (hasIVectorVersion(rThis, 3)) {
+			(void)rThis.abiGetData(pResult);
+		}
+		else if (!rThis.abiGetAt(0, pResult)) {
 			pResult = lia_NULLPTR;
 		}
 		return pResult;
@@ -407,25 +555,24 @@ public:
 	typename lia::detail::EnableIf<!lia::detail::IsLiaInterface<U>::value, const U*>::type data() const lia_NOEXCEPT {
 		const TInterface& rThis = downCast().getAbi();
 		const U* pResult;
-		if (!rThis.abiGetAtConst(0, pResult)) {
+		if (hasIVectorVersion(rThis, 3)) {
+			(void)rThis.abiGetDataConst(pResult);
+		}
+		else if (!rThis.abiGetAtConst(0, pResult)) {
 			pResult = lia_NULLPTR;
 		}
 		return pResult;
 	}
 
 	TIterator begin() lia_NOEXCEPT {
-		TInterface& rThis = downCast().getAbi();
 		TIterator iter;
-		rThis.abiConstructIterator(abi_true, iter.getBuffer());
-		iter.setConstructed();
+		initIterator(downCast().getAbi(), iter, true);
 		return iter;
 	}
 
 	TConstIterator begin() const lia_NOEXCEPT {
-		const TInterface& rThis = downCast().getAbi();
 		TConstIterator iter;
-		rThis.abiConstructConstIterator(abi_true, iter.getBuffer());
-		iter.setConstructed();
+		initIterator(downCast().getAbi(), iter, true);
 		return iter;
 	}
 
@@ -434,18 +581,14 @@ public:
 	}
 
 	TIterator end() lia_NOEXCEPT {
-		TInterface& rThis = downCast().getAbi();
 		TIterator iter;
-		rThis.abiConstructIterator(abi_false, iter.getBuffer());
-		iter.setConstructed();
+		initIterator(downCast().getAbi(), iter, false);
 		return iter;
 	}
 
 	TConstIterator end() const lia_NOEXCEPT {
-		const TInterface& rThis = downCast().getAbi();
 		TConstIterator iter;
-		rThis.abiConstructConstIterator(abi_false, iter.getBuffer());
-		iter.setConstructed();
+		initIterator(downCast().getAbi(), iter, false);
 		return iter;
 	}
 
@@ -454,27 +597,43 @@ public:
 	}
 
 	reverse_iterator rbegin() lia_NOEXCEPT {
-		return reverse_iterator(end());
+		reverse_iterator iter;
+		if (!constructReverseIterator(downCast().getAbi(), iter, true)) {
+			iter = reverse_iterator(end());
+		}
+		return iter;
 	}
 
 	reverse_iterator rend() lia_NOEXCEPT {
-		return reverse_iterator(begin());
+		reverse_iterator iter;
+		if (!constructReverseIterator(downCast().getAbi(), iter, false)) {
+			iter = reverse_iterator(begin());
+		}
+		return iter;
 	}
 
 	const_reverse_iterator rbegin() const lia_NOEXCEPT {
-		return const_reverse_iterator(end());
+		const_reverse_iterator iter;
+		if (!constructReverseIterator(downCast().getAbi(), iter, true)) {
+			iter = const_reverse_iterator(end());
+		}
+		return iter;
 	}
 
 	const_reverse_iterator rend() const lia_NOEXCEPT {
-		return const_reverse_iterator(begin());
+		const_reverse_iterator iter;
+		if (!constructReverseIterator(downCast().getAbi(), iter, false)) {
+			iter = const_reverse_iterator(begin());
+		}
+		return iter;
 	}
 
 	const_reverse_iterator rcbegin() const lia_NOEXCEPT {
-		return const_reverse_iterator(end());
+		return rbegin();
 	}
 
 	const_reverse_iterator rcend() const lia_NOEXCEPT {
-		return const_reverse_iterator(begin());
+		return rend();
 	}
 
 	bool empty() const lia_NOEXCEPT {
@@ -498,6 +657,13 @@ public:
 		}
 	}
 
+	//! Makes sure that n more elements can be added without reallocation. When the capacity needs to grow,
+	//! it is multiplied by growthPercent/100 (but grows at least to the required size). Pass kGrowthExact
+	//! to reserve exactly the required capacity.
+	void reserveAdditional(std::size_t n, uint32_t growthPercent = kGrowthDefault) {
+		reserveAdditionalImpl(downCast().getAbi(), static_cast<abi_size_t>(n), growthPercent);
+	}
+
 	std::size_t capacity() const lia_NOEXCEPT {
 		const TInterface& rThis = downCast().getAbi();
 		abi_size_t result = 0;
@@ -555,6 +721,17 @@ public:
 		return insertImpl(distanceFromBegin, ilist.begin(), ilist.end());
 	}
 
+	//! The implementation moves from value instead of copying it if it supports that (IVector version 0.14)
+	iterator insert(const_iterator pos, T&& value) {
+		const std::ptrdiff_t distanceFromBegin = pos - cbegin();
+		return insertMoveImpl(distanceFromBegin, value);
+	}
+
+	iterator insert(lia_NONCONST_ITER pos, T&& value) {
+		const std::ptrdiff_t distanceFromBegin = pos - begin();
+		return insertMoveImpl(distanceFromBegin, value);
+	}
+
 	template<typename... Args> 
 	iterator emplace(const_iterator pos, Args&&... args) {
 		return insert(pos, T(std::forward<Args>(args)...));
@@ -585,7 +762,7 @@ public:
 	}
 
 	void push_back(const T& value) {
-		const TInterface& rThis = downCast().getAbi();
+		TInterface& rThis = downCast().getAbi();
 		typename lia::detail::MakeTypes<T>::ConstPointer pElem;
 		assignElemPtr(pElem, value);
 		const abi_size_t size = rThis.abiGetSize();
@@ -596,69 +773,1750 @@ public:
 
 #if lia_CPP11_API
 
+	//! The implementation moves from value instead of copying it if it supports that (IVector version 0.14)
 	void push_back(T&& value) {
-		const T& tmp = value;
-		push_back(tmp);
+		TInterface& rThis = downCast().getAbi();
+		if (!insertMove(rThis, rThis.abiGetSize(), value)) {
+			lia_THROW0(std::bad_alloc);
+		}
 	}
 
-#endif
-
-	// helper functions
-
+	//! For vectors of vectors: The inner vector is moved into the implementation if that was built with the same toolchain
+	//! and uses the same container type (see tryNative()), and copied otherwise
 	template<typename U, typename V>
-	operator std::vector<U, V>() const lia_NOEXCEPT {
-		const TInterface& rThis = downCast().getAbi();
-		std::vector<U, V> v;
-		const abi_size_t sz = rThis.abiGetSize();
-		v.reserve(static_cast<std::size_t>(sz));
-		TConstPointer pElem;
-		for (abi_size_t i=0; i<sz; ++i) {
-			(void)rThis.abiGetAtConst(i, pElem);
-			v.push_back(derefElemPtr(pElem));
+	void push_back(std::vector<U, V>&& value) {
+		TInterface& rThis = downCast().getAbi();
+		if (!insertMove(rThis, rThis.abiGetSize(), value)) {
+			lia_THROW0(std::bad_alloc);
 		}
-		return v;
 	}
 
-private:
+#endif
 
-	iterator insertImpl(std::ptrdiff_t distanceFromBegin, std::size_t n, const T& value) {
+	//! Exchanges the elements with other. That is done in constant time without copying the elements
+	//! when both vectors were built with the same toolchain and use the same container type (see tryNative()).
+	void swap(TInterface& other) {
 		TInterface& rThis = downCast().getAbi();
-		if (distanceFromBegin < 0) {
-				lia_THROW1(std::out_of_range, "in insert() call");
+		if (&other == &rThis) {
+			return;
 		}
-		if (!rThis.abiReserve(static_cast<abi_size_t>(n))) {
+		if (swapStorage(rThis, other)) {
+			return;
+		}
+		// Without access to each other's storage: Append the elements of each vector to the other one and remove
+		// the original elements only when both copies succeeded, so that a failure leaves both vectors unchanged.
+		const abi_size_t thisSize  = rThis.abiGetSize();
+		const abi_size_t otherSize = other.abiGetSize();
+		reserveAdditionalImpl(rThis, otherSize, kGrowthExact);
+		reserveAdditionalImpl(other, thisSize, kGrowthExact);
+		if (!insertFromImpl(rThis, thisSize, other, 0, otherSize)) {
+			lia_THROW0(std::bad_alloc);
+		}
+		if (!insertFromImpl(other, otherSize, rThis, 0, thisSize)) {
+			(void)rThis.abiRemove(thisSize, otherSize);
 			lia_THROW0(std::bad_alloc);
 		}
+		(void)rThis.abiRemove(0, thisSize);
+		(void)other.abiRemove(0, otherSize);
+	}
+
+	void pop_back() lia_NOEXCEPT {
+		TInterface& rThis = downCast().getAbi();
+		if (hasIVectorVersion(rThis, 7)) {
+			(void)rThis.abiPopBack();
+		}
+		else {
+			const abi_size_t size = rThis.abiGetSize();
+			if (size > 0) {
+				(void)rThis.abiRemove(size - 1u);
+			}
+		}
+	}
+
+	void resize(std::size_t count) {
+		TInterface& rThis = downCast().getAbi();
+		if (hasIVectorVersion(rThis, 7)) {
+			if (!rThis.abiResize(static_cast<abi_size_t>(count))) {
+				lia_THROW0(std::bad_alloc);
+			}
+		}
+		else {
+			resizeDefaultFallback(rThis, static_cast<abi_size_t>(count), IsContiguousTag());
+		}
+	}
+
+	void resize(std::size_t count, const T& value) {
+		TInterface& rThis = downCast().getAbi();
 		typename lia::detail::MakeTypes<T>::ConstPointer pElem;
 		assignElemPtr(pElem, value);
-		std::ptrdiff_t j = distanceFromBegin;
-		for (std::size_t i=0; i<n; ++i, ++j) {
-			if (!rThis.abiInsert(static_cast<abi_size_t>(j), pElem)) {
+		if (hasIVectorVersion(rThis, 7)) {
+			if (!rThis.abiResize(static_cast<abi_size_t>(count), &pElem)) {
 				lia_THROW0(std::bad_alloc);
 			}
 		}
-		return begin() + distanceFromBegin;
+		else {
+			resizeFallback(rThis, static_cast<abi_size_t>(count), pElem);
+		}
 	}
 
-	template<class InputIt>
-	iterator insertImpl(std::ptrdiff_t distanceFromBegin, InputIt first, InputIt last) {
-		TInterface& rThis = downCast().getAbi();
-		if (distanceFromBegin < 0) {
-				lia_THROW1(std::out_of_range, "in insert() call");
+#if lia_CPP11_API
+
+	template<typename... Args>
+	TReference emplace_back(Args&&... args) {
+		push_back(T(std::forward<Args>(args)...));
+		return back();
+	}
+
+	//! Value-initializes the new element inside the implementation, which also works for vectors of vectors
+	TReference emplace_back() {
+		resize(size() + 1u);
+		return back();
+	}
+
+#endif
+
+	// helper functions
+
+	//! Calls func(element) for all elements in order. Elements of lia interface types are fetched in chunks
+	//! with one call over the ABI boundary per chunk, other elements are accessed directly in their storage.
+	//! Throws std::out_of_range when the implementation fails to hand out its elements.
+	template<typename TFunc>
+	TFunc forEach(TFunc func) {
+		forEachImpl(downCast().getAbi(), func, IsContiguousTag());
+		return func;
+	}
+
+	template<typename TFunc>
+	TFunc forEach(TFunc func) const {
+		forEachImpl(downCast().getAbi(), func, IsContiguousTag());
+		return func;
+	}
+
+	//! Calls func(chunk, n) for all elements in order. The calls are made from inside the module that owns
+	//! the vector, so that there's one call over the ABI boundary per chunk instead of one per element.
+	//! For element types other than lia interfaces, chunk points to n consecutive elements, otherwise it's
+	//! an array of n proxies. func returns false to stop the traversal. Returns true if all elements were
+	//! visited.
+	template<typename TFunc>
+	bool visitChunks(TFunc func) {
+		return visitChunksImpl(downCast().getAbi(), 0, npos(), func);
+	}
+
+	template<typename TFunc>
+	bool visitChunks(TFunc func) const {
+		return visitChunksImpl(downCast().getAbi(), 0, npos(), func);
+	}
+
+	//! Like visitChunks(func), but only for the elements [pos, pos + count). count is limited to size() - pos.
+	template<typename TFunc>
+	bool visitChunks(std::size_t pos, std::size_t count, TFunc func) {
+		return visitChunksImpl(downCast().getAbi(), pos, count, func);
+	}
+
+	template<typename TFunc>
+	bool visitChunks(std::size_t pos, std::size_t count, TFunc func) const {
+		return visitChunksImpl(downCast().getAbi(), pos, count, func);
+	}
+
+	//! For vectors of vectors: Returns the number of elements of all inner vectors
+	std::size_t flatSize() const {
+		lia_STATIC_ASSERT((lia::detail::FlatTypes<T>::isFlattenable), "Only vectors of vectors of non-interface types can be flattened")
+		const TInterface& rThis = downCast().getAbi();
+		if (hasIVectorVersion(rThis, 11)) {
+			abi_size_t numValues = 0;
+			(void)rThis.abiExportFlat(lia_NULLPTR, lia_NULLPTR, &numValues);
+			return static_cast<std::size_t>(numValues);
 		}
-		const std::size_t n = static_cast<std::size_t>(std::distance<InputIt>(first, last));
-		if (!rThis.abiReserve(static_cast<abi_size_t>(n))) {
-			lia_THROW0(std::bad_alloc);
+		std::size_t numValues = 0;
+		forEach(FlatSizeCounter(numValues));
+		return numValues;
+	}
+
+	//! For vectors of vectors: Writes all elements in compressed sparse row format with one call over the ABI boundary.
+	//! pOffsets receives size()+1 entries, inner vector i is written to pValues[pOffsets[i]] ... pValues[pOffsets[i+1]-1].
+	//! valuesCapacity is the number of elements pValues can hold and must be at least flatSize().
+	void exportFlat(abi_size_t* pOffsets, typename lia::detail::FlatTypes<T>::Value* pValues, std::size_t valuesCapacity) const {
+		lia_STATIC_ASSERT((lia::detail::FlatTypes<T>::isFlattenable), "Only vectors of vectors of non-interface types can be flattened")
+		typedef typename lia::detail::FlatTypes<T>::Value TValue;
+		const TInterface& rThis = downCast().getAbi();
+		if (hasIVectorVersion(rThis, 11)) {
+			abi_size_t numValues = static_cast<abi_size_t>(valuesCapacity);
+			if (!rThis.abiExportFlat(pOffsets, pValues, &numValues)) {
+				lia_THROW1(std::length_error, "in exportFlat() call");
+			}
+			return;
 		}
-		typename lia::detail::MakeTypes<T>::ConstPointer pElem;
-		std::ptrdiff_t j = distanceFromBegin;
-		for (InputIt iter = first; iter != last; ++iter, ++j) {
-			assignElemPtr(pElem, *iter);
-			if (!rThis.abiInsert(static_cast<abi_size_t>(j), pElem)) {
+		const std::vector< std::vector<TValue> > rows = *this;
+		std::size_t offset = 0;
+		for (std::size_t i=0; i<rows.size(); ++i) {
+			if (rows[i].size() > (valuesCapacity - offset)) {
+				lia_THROW1(std::length_error, "in exportFlat() call");
+			}
+			pOffsets[i] = static_cast<abi_size_t>(offset);
+			std::copy(rows[i].begin(), rows[i].end(), pValues + offset);
+			offset += rows[i].size();
+		}
+		pOffsets[rows.size()] = static_cast<abi_size_t>(offset);
+	}
+
+	template<typename A, typename B>
+	void exportFlat(std::vector<abi_size_t, A>& offsets, std::vector<typename lia::detail::FlatTypes<T>::Value, B>& values) const {
+		values.resize(flatSize());
+		offsets.resize(size() + 1u);
+		exportFlat(&offsets[0], values.empty() ? lia_NULLPTR : &values[0], values.size());
+	}
+
+	//! For vectors of vectors: Replaces the contents by numRows inner vectors read from compressed sparse row format
+	//! with one call over the ABI boundary. pOffsets has numRows+1 non-decreasing entries, inner vector i consists of
+	//! pValues[pOffsets[i]] ... pValues[pOffsets[i+1]-1].
+	void importFlat(const abi_size_t* pOffsets, std::size_t numRows, const typename lia::detail::FlatTypes<T>::Value* pValues) {
+		lia_STATIC_ASSERT((lia::detail::FlatTypes<T>::isFlattenable), "Only vectors of vectors of non-interface types can be flattened")
+		typedef typename lia::detail::FlatTypes<T>::Value TValue;
+		for (std::size_t i=0; i<numRows; ++i) {
+			if (pOffsets[i] > pOffsets[i + 1]) {
+				lia_THROW1(std::invalid_argument, "in importFlat() call");
+			}
+		}
+		TInterface& rThis = downCast().getAbi();
+		if (hasIVectorVersion(rThis, 11)) {
+			if (!rThis.abiImportFlat(pOffsets, static_cast<abi_size_t>(numRows), pValues)) {
 				lia_THROW0(std::bad_alloc);
 			}
+			return;
 		}
-		return begin() + distanceFromBegin;
+		std::vector< std::vector<TValue> > rows(numRows);
+		for (std::size_t i=0; i<numRows; ++i) {
+			rows[i].assign(pValues + pOffsets[i], pValues + pOffsets[i + 1]);
+		}
+		(void)operator=(rows);
+	}
+
+	//! Element-wise comparison. Elements that are equal exactly when their bytes are equal are compared with one
+	//! memcmp() when both vectors hand out their storage, otherwise the elements are fetched in chunks. The comparisons
+	//! throw std::out_of_range when an implementation fails to hand out its elements, like the searches do.
+	bool operator==(const TInterface& other) const {
+		return isEqual(downCast().getAbi(), other, IsContiguousTag());
+	}
+
+	bool operator!=(const TInterface& other) const {
+		return !isEqual(downCast().getAbi(), other, IsContiguousTag());
+	}
+
+	//! Lexicographical comparison, like for std::vector
+	bool operator<(const TInterface& other) const {
+		return isLess(downCast().getAbi(), other, IsContiguousTag());
+	}
+
+	bool operator>(const TInterface& other) const {
+		return isLess(other, downCast().getAbi(), IsContiguousTag());
+	}
+
+	bool operator<=(const TInterface& other) const {
+		return !isLess(other, downCast().getAbi(), IsContiguousTag());
+	}
+
+	bool operator>=(const TInterface& other) const {
+		return !isLess(downCast().getAbi(), other, IsContiguousTag());
+	}
+
+#if lia_CPP11_API
+
+	//! Hash of the elements, which is the same for vectors that compare equal. Elements that are equal exactly when
+	//! their bytes are equal are hashed as one block of memory, others with std::hash. Throws std::out_of_range when the
+	//! implementation fails to hand out its elements.
+	std::size_t hashValue() const {
+		const TInterface& rThis = downCast().getAbi();
+		const abi_size_t size = rThis.abiGetSize();
+		const uint64_t h = hashImpl(rThis, size, lia::detail::hashCombine(0u, static_cast<uint64_t>(size)), lia::detail::BoolType<lia::detail::IsBitwiseComparable<T>::value>());
+		return static_cast<std::size_t>(lia::detail::hashFinalize(h));
+	}
+
+#endif
+
+	//! Returns a non-owning view of the elements, which can be passed to range algorithms and std::span without copying.
+	//! See lia::VectorView for details.
+	lia::VectorView<T> view() {
+		return lia::VectorView<T>(downCast().getAbi());
+	}
+
+	lia::VectorView<const T> view() const {
+		return lia::VectorView<const T>(downCast().getAbi());
+	}
+
+	//! Sorts the elements with operator<, like std::sort(). Elements of types other than lia interfaces are sorted
+	//! directly in the storage of the vector. Others are sorted by the module owning the vector, which calls back
+	//! for each comparison if a comparator is passed (IVector version 0.15).
+	void sort() {
+		sortImpl(kSortUnstable, 0u, lia::detail::DefaultLess(), 1u);
+	}
+
+	template<typename TLess>
+	void sort(TLess less) {
+		sortImpl(kSortUnstable, 0u, less, 1u);
+	}
+
+	//! Like sort(), but keeps the order of equal elements, like std::stable_sort()
+	void stableSort() {
+		sortImpl(kSortStable, 0u, lia::detail::DefaultLess(), 1u);
+	}
+
+	template<typename TLess>
+	void stableSort(TLess less) {
+		sortImpl(kSortStable, 0u, less, 1u);
+	}
+
+	//! Sorts the smallest middle elements into [0, middle), like std::partial_sort()
+	void partialSort(std::size_t middle) {
+		sortImpl(kSortPartial, middle, lia::detail::DefaultLess(), 1u);
+	}
+
+	template<typename TLess>
+	void partialSort(std::size_t middle, TLess less) {
+		sortImpl(kSortPartial, middle, less, 1u);
+	}
+
+	//! Puts the element that sorting would put at index nth there, with no greater elements before and no
+	//! smaller elements after it, like std::nth_element()
+	void nthElement(std::size_t nth) {
+		sortImpl(kSortNthElement, nth, lia::detail::DefaultLess(), 1u);
+	}
+
+	template<typename TLess>
+	void nthElement(std::size_t nth, TLess less) {
+		sortImpl(kSortNthElement, nth, less, 1u);
+	}
+
+	//! Like sort(), but sorts parts of the vector on up to numThreads threads and merges them afterwards. With numThreads
+	//! being 0, there's one thread per hardware thread. less is called from several threads at the same time. Without
+	//! C++11 support, this sorts on the calling thread.
+	void parallelSort(std::size_t numThreads = 0u) {
+		sortImpl(kSortUnstable, 0u, lia::detail::DefaultLess(), numThreads);
+	}
+
+	template<typename TLess>
+	void parallelSort(std::size_t numThreads, TLess less) {
+		sortImpl(kSortUnstable, 0u, less, numThreads);
+	}
+
+	//! Returns the index of the first element at or after pos that is equal to value, or size() if there's none.
+	//! Elements of types other than lia interfaces are compared directly in the storage of the vector, with vectorized
+	//! comparisons for arithmetic types. Others are compared by the module owning the vector (IVector version 0.16).
+	//! For vectors of vectors, value is a std::vector.
+	template<typename U>
+	std::size_t findIndex(const U& value, std::size_t pos = 0u) const {
+		return scanForValue<typename lia::detail::SearchValue<T, U>::Type>(kSearchFind, pos, value);
+	}
+
+	//! Returns the index of the first element at or after pos that pred is true for, or size() if there's none
+	template<typename TPred>
+	std::size_t findIndexIf(TPred pred, std::size_t pos = 0u) const {
+		return scanIf(kSearchFind, pos, pred);
+	}
+
+	//! Returns the number of elements equal to value
+	template<typename U>
+	std::size_t count(const U& value) const {
+		return scanForValue<typename lia::detail::SearchValue<T, U>::Type>(kSearchCount, 0u, value);
+	}
+
+	//! Returns the number of elements pred is true for
+	template<typename TPred>
+	std::size_t countIf(TPred pred) const {
+		return scanIf(kSearchCount, 0u, pred);
+	}
+
+	//! Returns the index of the first element of the sorted vector that isn't less than value, like std::lower_bound().
+	//! The binary search runs in the module owning the vector like findIndex().
+	template<typename U>
+	std::size_t lowerBound(const U& value) const {
+		return searchBoundsImpl<typename lia::detail::SearchValue<T, U>::Type>(kSearchLowerBound, value, lia::detail::DefaultLess()).first;
+	}
+
+	template<typename U, typename TLess>
+	std::size_t lowerBound(const U& value, TLess less) const {
+		return searchBoundsImpl<typename lia::detail::SearchValue<T, U>::Type>(kSearchLowerBound, value, less).first;
+	}
+
+	//! Returns the index of the first element of the sorted vector that is greater than value, like std::upper_bound()
+	template<typename U>
+	std::size_t upperBound(const U& value) const {
+		return searchBoundsImpl<typename lia::detail::SearchValue<T, U>::Type>(kSearchUpperBound, value, lia::detail::DefaultLess()).first;
+	}
+
+	template<typename U, typename TLess>
+	std::size_t upperBound(const U& value, TLess less) const {
+		return searchBoundsImpl<typename lia::detail::SearchValue<T, U>::Type>(kSearchUpperBound, value, less).first;
+	}
+
+	//! Returns the indices lowerBound(value) and upperBound(value) with one search, like std::equal_range()
+	template<typename U>
+	std::pair<std::size_t, std::size_t> equalRange(const U& value) const {
+		return searchBoundsImpl<typename lia::detail::SearchValue<T, U>::Type>(kSearchEqualRange, value, lia::detail::DefaultLess());
+	}
+
+	template<typename U, typename TLess>
+	std::pair<std::size_t, std::size_t> equalRange(const U& value, TLess less) const {
+		return searchBoundsImpl<typename lia::detail::SearchValue<T, U>::Type>(kSearchEqualRange, value, less);
+	}
+
+	//! Reductions for vectors of arithmetic types. They run directly on the storage of the vector, or in the module owning
+	//! it (IVector version 0.17), with SSE2 or AVX2 kernels for int32_t, float and double depending on the CPU. Integers
+	//! are summed up as 64 bit integers, floating point values as double. Floating point sums depend on the kernel's
+	//! order of additions. Minimum and maximum are NaN if there are NaN values.
+	typename lia::detail::ReduceTypes<typename lia::detail::RemoveConst<T>::type>::Sum sum() const {
+		typename lia::detail::ReduceTypes<typename lia::detail::RemoveConst<T>::type>::Sum result = 0;
+		reduceImpl(kReduceSum, lia_NULLPTR, &result);
+		return result;
+	}
+
+	//! Sum of the products of the elements of this and other, which must have the same size
+	typename lia::detail::ReduceTypes<typename lia::detail::RemoveConst<T>::type>::Sum dot(const TInterface& other) const {
+		typename lia::detail::ReduceTypes<typename lia::detail::RemoveConst<T>::type>::Sum result = 0;
+		reduceImpl(kReduceDot, &other, &result);
+		return result;
+	}
+
+	//! Smallest element. Throws std::out_of_range for an empty vector.
+	typename lia::detail::ReduceTypes<typename lia::detail::RemoveConst<T>::type>::Value minValue() const {
+		typename lia::detail::ReduceTypes<typename lia::detail::RemoveConst<T>::type>::Value result = 0;
+		reduceImpl(kReduceMin, lia_NULLPTR, &result);
+		return result;
+	}
+
+	//! Greatest element. Throws std::out_of_range for an empty vector.
+	typename lia::detail::ReduceTypes<typename lia::detail::RemoveConst<T>::type>::Value maxValue() const {
+		typename lia::detail::ReduceTypes<typename lia::detail::RemoveConst<T>::type>::Value result = 0;
+		reduceImpl(kReduceMax, lia_NULLPTR, &result);
+		return result;
+	}
+
+	//! Index of the first smallest element, or of the first NaN value if there is one. 0 for an empty vector.
+	std::size_t argMin() const {
+		abi_size_t result = 0;
+		reduceImpl(kReduceArgMin, lia_NULLPTR, &result);
+		return static_cast<std::size_t>(result);
+	}
+
+	//! Index of the first greatest element, or of the first NaN value if there is one. 0 for an empty vector.
+	std::size_t argMax() const {
+		abi_size_t result = 0;
+		reduceImpl(kReduceArgMax, lia_NULLPTR, &result);
+		return static_cast<std::size_t>(result);
+	}
+
+	//! Counts the elements in numBins bins of equal width over [lower, upper). pCounts receives numBins counts.
+	//! Elements outside of the range aren't counted.
+	void histogram(double lower, double upper, std::size_t numBins, abi_size_t* pCounts) const {
+		typedef typename lia::detail::RemoveConst<T>::type TNonConst;
+		if ((numBins == 0u) || !(lower < upper) || (pCounts == lia_NULLPTR)) {
+			lia_THROW1(std::invalid_argument, "in histogram() call");
+		}
+		const TInterface& rThis = downCast().getAbi();
+		const abi_size_t size = rThis.abiGetSize();
+		const T* pData = lia_NULLPTR;
+		if (hasIVectorVersion(rThis, 3) && rThis.abiGetDataConst(pData)) {
+			(void)lia::detail::ReduceRange<true>::histogram(pData, static_cast<std::size_t>(size), lower, upper, numBins, pCounts);
+		}
+		else if (!hasIVectorVersion(rThis, 17) || !rThis.abiHistogram(0, size, lower, upper, static_cast<abi_size_t>(numBins), pCounts)) {
+			std::vector<TNonConst> values;
+			copyToImpl(rThis, values, IsContiguousTag());
+			(void)lia::detail::ReduceRange<true>::histogram(values.empty() ? lia_NULLPTR : &values[0], values.size(), lower, upper, numBins, pCounts);
+		}
+	}
+
+	template<typename A>
+	void histogram(double lower, double upper, std::size_t numBins, std::vector<abi_size_t, A>& counts) const {
+		counts.resize(numBins);
+		histogram(lower, upper, numBins, counts.empty() ? lia_NULLPTR : &counts[0]);
+	}
+
+	//! Removes the elements pred is true for and returns their number, like std::erase_if(). This is done in one pass that moves
+	//! each remaining element at most once, in the storage of the vector or in the module owning it (IVector version 0.18),
+	//! instead of one erase() per removed element. If pred throws, the vector is left in a valid but unspecified state.
+	template<typename TPred>
+	std::size_t eraseIf(TPred pred) {
+		TInterface& rThis = downCast().getAbi();
+		std::size_t numRemoved = 0u;
+		if (eraseIfInStorage(rThis, pred, numRemoved, IsContiguousTag())) {
+			return numRemoved;
+		}
+		lia::detail::CallbackContext<TPred> context(pred);
+		const bool isOk = removeWithCallback(rThis, context, &lia::detail::CallbackContext<TPred>::template test<TConstPointer>, numRemoved);
+		context.rethrowIfFailed();
+		if (!isOk) {
+			lia_THROW0(std::bad_alloc);
+		}
+		return numRemoved;
+	}
+
+	//! Removes all but the first element of each group of consecutive equal elements, like std::unique() followed by erase(),
+	//! and returns the number of removed elements. Runs in one pass like eraseIf().
+	std::size_t unique() {
+		return uniqueImpl(lia::detail::DefaultEqual());
+	}
+
+	template<typename TEqual>
+	std::size_t unique(TEqual equal) {
+		return uniqueImpl(equal);
+	}
+
+	//! Keeps the elements selected by pMask and removes the others in one pass like eraseIf(). pMask has maskSize bytes
+	//! in the format kMaskBytes or kMaskBits. std::invalid_argument is thrown if it doesn't cover all elements.
+	//! Returns the number of removed elements.
+	std::size_t keepMasked(const uint8_t* pMask, std::size_t maskSize, uint32_t maskFormat = kMaskBytes) {
+		TInterface& rThis = downCast().getAbi();
+		const std::size_t size = static_cast<std::size_t>(rThis.abiGetSize());
+		if ((maskFormat > kMaskBits) || ((pMask == lia_NULLPTR) && (size > 0u)) || !lia::detail::coversElements(maskSize, maskFormat, size)) {
+			lia_THROW1(std::invalid_argument, "in keepMasked() call");
+		}
+		std::size_t numRemoved = 0u;
+		if (keepMaskedInStorage(rThis, pMask, maskSize, maskFormat, numRemoved, IsContiguousTag())) {
+			return numRemoved;
+		}
+		if (hasIVectorVersion(rThis, 18)) {
+			abi_size_t num = 0;
+			if (!rThis.abiKeepMasked(pMask, static_cast<abi_size_t>(maskSize), maskFormat, &num)) {
+				lia_THROW0(std::bad_alloc);
+			}
+			return static_cast<std::size_t>(num);
+		}
+		return removeRunsFallback(rThis, size, lia::detail::MaskedOut(pMask, maskFormat));
+	}
+
+	template<typename A>
+	std::size_t keepMasked(const std::vector<uint8_t, A>& mask, uint32_t maskFormat = kMaskBytes) {
+		return keepMasked(mask.empty() ? lia_NULLPTR : &mask[0], mask.size(), maskFormat);
+	}
+
+	//! Copies the elements at the n indices pIndices to pOut, like pOut[i] = (*this)[pIndices[i]]. This is done directly in
+	//! the storage of the vector, with AVX2 for trivially copyable elements of 4 and 8 bytes if the CPU supports it, or with
+	//! one call into the module owning the vector per chunk of indices (IVector version 0.19) instead of one per element.
+	//! All indices are checked first, and std::out_of_range is thrown without copying anything if one is invalid.
+	//! For vectors of vectors, pOut points to std::vectors.
+	template<typename U>
+	void gather(const abi_size_t* pIndices, std::size_t n, U* pOut) const {
+		if (n == 0u) {
+			return;
+		}
+		if ((pIndices == lia_NULLPTR) || (pOut == lia_NULLPTR)) {
+			lia_THROW1(std::invalid_argument, "in gather() call");
+		}
+		const TInterface& rThis = downCast().getAbi();
+		if (!gatherInStorage(rThis, pIndices, n, pOut, IsContiguousTag())) {
+			gatherByOwner(rThis, pIndices, n, pOut);
+		}
+	}
+
+	template<typename A, typename U, typename B>
+	void gather(const std::vector<abi_size_t, A>& indices, std::vector<U, B>& out) const {
+		out.resize(indices.size());
+		if (!indices.empty()) {
+			gather(&indices[0], indices.size(), &out[0]);
+		}
+	}
+
+	//! Assigns the n values pValues to the elements at the indices pIndices, like (*this)[pIndices[i]] = pValues[i], in the
+	//! storage of the vector or in the module owning it like gather(). If an index occurs more than once, the last of its
+	//! values is assigned. All indices are checked first like for gather(). pValues points to elements of type T, or to
+	//! std::vectors for vectors of vectors.
+	template<typename U>
+	void scatter(const abi_size_t* pIndices, std::size_t n, const U* pValues) {
+		if (n == 0u) {
+			return;
+		}
+		if ((pIndices == lia_NULLPTR) || (pValues == lia_NULLPTR)) {
+			lia_THROW1(std::invalid_argument, "in scatter() call");
+		}
+		TInterface& rThis = downCast().getAbi();
+		if (!scatterInStorage(rThis, pIndices, n, pValues, IsContiguousTag())) {
+			scatterByOwner(rThis, pIndices, n, pValues);
+		}
+	}
+
+	template<typename A, typename U, typename B>
+	void scatter(const std::vector<abi_size_t, A>& indices, const std::vector<U, B>& values) {
+		if (values.size() != indices.size()) {
+			lia_THROW1(std::invalid_argument, "in scatter() call");
+		}
+		if (!indices.empty()) {
+			scatter(&indices[0], indices.size(), &values[0]);
+		}
+	}
+
+	//! Returns the kCap... flags of the implementation. For implementations before IVector version 0.12,
+	//! they are derived from the interface version.
+	uint32_t capabilities() const lia_NOEXCEPT {
+		return getCapabilities(downCast().getAbi());
+	}
+
+	//! Throws std::out_of_range when the implementation fails to hand out its elements
+	template<typename U, typename V>
+	operator std::vector<U, V>() const {
+		const TInterface& rThis = downCast().getAbi();
+		std::vector<U, V> v;
+		copyToImpl(rThis, v, IsContiguousTag());
+		return v;
+	}
+
+private:
+
+	// Elements of types other than lia interfaces have the same layout on both sides of the ABI boundary
+	// and are stored contiguously by the implementation
+	typedef lia::detail::BoolType<!lia::detail::IsLiaInterface<typename lia::detail::RemoveConst<T>::type>::value> IsContiguousTag;
+
+	template<typename U>
+	static void initIterator(TInterface& rThis, lia::VectorIteratorHandle<U>& iter, bool atBegin) lia_NOEXCEPT {
+		rThis.abiConstructIterator(atBegin ? abi_true : abi_false, iter.getBuffer());
+		iter.setConstructed();
+	}
+
+	template<typename U>
+	static void initIterator(const TInterface& rThis, lia::VectorIteratorHandle<U>& iter, bool atBegin) lia_NOEXCEPT {
+		rThis.abiConstructConstIterator(atBegin ? abi_true : abi_false, iter.getBuffer());
+		iter.setConstructed();
+	}
+
+	template<typename TVector, typename U>
+	static void initIterator(TVector& rThis, lia::VectorIndexIterator<U>& iter, bool atBegin) lia_NOEXCEPT {
+		iter = lia::VectorIndexIterator<U>(rThis, atBegin ? 0 : static_cast<std::ptrdiff_t>(rThis.abiGetSize()));
+	}
+
+	// Reverse iterators over handles iterate backwards over the native reverse iterators of the implementation, so
+	// that dereferencing doesn't need to clone and decrement the handle. Index iterators are cheap to copy already.
+	template<typename U>
+	static bool constructReverseIterator(TInterface& rThis, lia::detail::ReverseIterator< lia::VectorIteratorHandle<U> >& result, bool atBegin) lia_NOEXCEPT {
+		if (!hasIVectorVersion(rThis, 10)) {
+			return false;
+		}
+		lia::VectorIteratorHandle<U> iter;
+		rThis.abiConstructReverseIterator(atBegin ? abi_true : abi_false, iter.getBuffer());
+		iter.setConstructed();
+		result = lia::detail::ReverseIterator< lia::VectorIteratorHandle<U> >(iter, lia::detail::NativeReverse());
+		return true;
+	}
+
+	template<typename U>
+	static bool constructReverseIterator(const TInterface& rThis, lia::detail::ReverseIterator< lia::VectorIteratorHandle<U> >& result, bool atBegin) lia_NOEXCEPT {
+		if (!hasIVectorVersion(rThis, 10)) {
+			return false;
+		}
+		lia::VectorIteratorHandle<U> iter;
+		rThis.abiConstructReverseConstIterator(atBegin ? abi_true : abi_false, iter.getBuffer());
+		iter.setConstructed();
+		result = lia::detail::ReverseIterator< lia::VectorIteratorHandle<U> >(iter, lia::detail::NativeReverse());
+		return true;
+	}
+
+	template<typename TVector, typename U>
+	static bool constructReverseIterator(TVector&, lia::detail::ReverseIterator< lia::VectorIndexIterator<U> >&, bool) lia_NOEXCEPT {
+		return false;
+	}
+
+	iterator insertImpl(std::ptrdiff_t distanceFromBegin, std::size_t n, const T& value) {
+		TInterface& rThis = downCast().getAbi();
+		if (distanceFromBegin < 0) {
+				lia_THROW1(std::out_of_range, "in insert() call");
+		}
+		reserveAdditionalImpl(rThis, static_cast<abi_size_t>(n), kGrowthDefault);
+		typename lia::detail::MakeTypes<T>::ConstPointer pElem;
+		assignElemPtr(pElem, value);
+		if (!insertFill(rThis, static_cast<abi_size_t>(distanceFromBegin), static_cast<abi_size_t>(n), pElem)) {
+			lia_THROW0(std::bad_alloc);
+		}
+		return begin() + distanceFromBegin;
+	}
+
+#if lia_CPP11_API
+
+	iterator insertMoveImpl(std::ptrdiff_t distanceFromBegin, T& value) {
+		TInterface& rThis = downCast().getAbi();
+		if (distanceFromBegin < 0) {
+				lia_THROW1(std::out_of_range, "in insert() call");
+		}
+		if (!insertMove(rThis, static_cast<abi_size_t>(distanceFromBegin), value)) {
+			lia_THROW0(std::bad_alloc);
+		}
+		return begin() + distanceFromBegin;
+	}
+
+	// Inserts value, which the implementation may move from. Implementations before version 0.14 copy it.
+	template<typename U>
+	static bool insertMove(TInterface& rThis, abi_size_t pos, U& value) {
+		if (hasIVectorVersion(rThis, 14)) {
+			typename lia::detail::MakeTypes<T>::Pointer pElem;
+			assignElemPtr(pElem, value);
+			return rThis.abiInsertMove(pos, pElem);
+		}
+		typename lia::detail::MakeTypes<T>::ConstPointer pElem;
+		assignElemPtr(pElem, static_cast<const U&>(value));
+		return rThis.abiInsert(pos, pElem);
+	}
+
+#endif
+
+	template<class InputIt>
+	iterator insertImpl(std::ptrdiff_t distanceFromBegin, InputIt first, InputIt last) {
+		if (distanceFromBegin < 0) {
+				lia_THROW1(std::out_of_range, "in insert() call");
+		}
+		if (!insertRangeImpl(static_cast<abi_size_t>(distanceFromBegin), first, last, kGrowthDefault)) {
+			lia_THROW0(std::bad_alloc);
+		}
+		return begin() + distanceFromBegin;
+	}
+
+	template<class InputIt>
+	bool insertRangeImpl(abi_size_t pos, InputIt first, InputIt last, uint32_t growthPercent) {
+		return insertRangeImpl(pos, first, last, growthPercent, typename std::iterator_traits<InputIt>::iterator_category());
+	}
+
+	// Single pass input iterators may return references to temporaries, so their elements are inserted one by one.
+	// Their number isn't known in advance, so no capacity is reserved. The inserted elements are removed again on failure.
+	template<class InputIt>
+	bool insertRangeImpl(abi_size_t pos, InputIt first, InputIt last, uint32_t, std::input_iterator_tag) {
+		TInterface& rThis = downCast().getAbi();
+		typename lia::detail::MakeTypes<T>::ConstPointer pElem;
+		abi_size_t n = 0;
+		for (InputIt iter = first; iter != last; ++iter, ++n) {
+			assignElemPtr(pElem, *iter);
+			if (!rThis.abiInsert(pos + n, pElem)) {
+				(void)rThis.abiRemove(pos, n);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Elements of forward iterators stay valid, so pointers to all of them are collected and inserted with one call
+	// over the ABI boundary. The implementation shifts the elements behind pos only once then.
+	template<class ForwardIt>
+	bool insertRangeImpl(abi_size_t pos, ForwardIt first, ForwardIt last, uint32_t growthPercent, std::forward_iterator_tag) {
+		TInterface& rThis = downCast().getAbi();
+		const abi_size_t n = static_cast<abi_size_t>(std::distance(first, last));
+		reserveAdditionalImpl(rThis, n, growthPercent);
+		typename lia::detail::MakeTypes<T>::ConstPointer chunk[kChunkSize];
+		std::vector<typename lia::detail::MakeTypes<T>::ConstPointer> elems;
+		typename lia::detail::MakeTypes<T>::ConstPointer* pElems = (n > kChunkSize) ? allocElemPtrs(elems, n) : chunk;
+		abi_size_t i = 0;
+		for (ForwardIt iter = first; iter != last; ++iter, ++i) {
+			assignElemPtr(pElems[i], *iter);
+		}
+		return insertChunk(rThis, pos, pElems, n, hasIVectorVersion(rThis, 2));
+	}
+
+	template<typename TElemPtr>
+	static TElemPtr* allocElemPtrs(std::vector<TElemPtr>& elems, abi_size_t n) {
+		elems.resize(static_cast<std::size_t>(n));
+		return &elems[0];
+	}
+
+	// Exchanges the storage of a and b if one of them can take over the other's. Implementations before
+	// IVector version 0.8 can't, but the other vector may still be able to.
+	static bool swapStorage(TInterface& a, TInterface& b) {
+		if (hasIVectorVersion(a, 8)) {
+			return a.abiSwap(b);
+		}
+		return hasIVectorVersion(b, 8) && b.abiSwap(a);
+	}
+
+	// Makes sure that n more elements fit into the vector. When it needs to grow, the new capacity is
+	// the current one multiplied by growthPercent/100, but at least the required one.
+	static void reserveAdditionalImpl(TInterface& rThis, abi_size_t n, uint32_t growthPercent) {
+		if (hasIVectorVersion(rThis, 6)) {
+			if (!rThis.abiReserveAdditional(n, growthPercent)) {
+				lia_THROW0(std::bad_alloc);
+			}
+			return;
+		}
+		abi_size_t capacity = 0;
+		const abi_size_t size = rThis.abiGetSize(&capacity);
+		const abi_size_t required = size + n;
+		if (required > capacity) {
+			abi_size_t newCapacity = required;
+			if (growthPercent > 100u) {
+				newCapacity = std::max(required, static_cast<abi_size_t>((capacity / 100u) * growthPercent + ((capacity % 100u) * growthPercent) / 100u));
+			}
+			if (!rThis.abiReserve(newCapacity)) {
+				lia_THROW0(std::bad_alloc);
+			}
+		}
+	}
+
+	static void resizeFallback(TInterface& rThis, abi_size_t count, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) {
+		const abi_size_t size = rThis.abiGetSize();
+		if (count < size) {
+			(void)rThis.abiRemove(count, size - count);
+		}
+		else if (count > size) {
+			if (!insertFill(rThis, size, count - size, pElem)) {
+				lia_THROW0(std::bad_alloc);
+			}
+		}
+	}
+
+	static void resizeDefaultFallback(TInterface& rThis, abi_size_t count, lia::detail::BoolType<true>) {
+		const T value = T();
+		typename lia::detail::MakeTypes<T>::ConstPointer pElem;
+		assignElemPtr(pElem, value);
+		resizeFallback(rThis, count, pElem);
+	}
+
+	static void resizeDefaultFallback(TInterface& rThis, abi_size_t count, lia::detail::BoolType<false>) {
+		if (count > rThis.abiGetSize()) {
+			// value-initialized interface elements can only be created by the implementation itself
+			lia_THROW1(std::logic_error, "resize() not supported by IVector implementation");
+		}
+		(void)rThis.abiRemove(count, rThis.abiGetSize() - count);
+	}
+
+	// Inserts the elements [first, first+n) of src at position pos into dst
+	static bool insertFromImpl(TInterface& dst, abi_size_t pos, const TInterface& src, abi_size_t first, abi_size_t n) {
+		const bool hasInsertRange = hasIVectorVersion(dst, 2);
+		const bool hasGetRange    = hasIVectorVersion(src, 4);
+		const T* pData = lia_NULLPTR;
+		const bool isContiguous = hasIVectorVersion(src, 3) && src.abiGetDataConst(pData);
+		if (isContiguous && (n > 0) && insertByMemcpy(dst, pos, pData + first, n, IsContiguousTag())) {
+			return true;
+		}
+		typename lia::detail::MakeTypes<T>::ConstPointer chunk[kChunkSize];
+		std::vector<typename lia::detail::MakeTypes<T>::ConstPointer> elems;
+		typename lia::detail::MakeTypes<T>::ConstPointer* pElems = (n > kChunkSize) ? allocElemPtrs(elems, n) : chunk;
+		if (isContiguous) {
+			pointToElements(pData + first, n, pElems, IsContiguousTag());
+		}
+		else if (!fetchChunk(src, first, n, pElems, hasGetRange)) {
+			return false;
+		}
+		return insertChunk(dst, pos, pElems, n, hasInsertRange);
+	}
+
+	static bool insertFill(TInterface& rThis, abi_size_t pos, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer& pElem) {
+		if (hasIVectorVersion(rThis, 5)) {
+			return rThis.abiInsertFill(pos, n, pElem);
+		}
+		for (abi_size_t i=0; i<n; ++i) {
+			if (!rThis.abiInsert(pos + i, pElem)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool insertChunk(TInterface& rThis, abi_size_t pos, typename lia::detail::MakeTypes<T>::ConstPointer* pChunk, abi_size_t n, bool hasInsertRange) {
+		if (hasInsertRange) {
+			return rThis.abiInsertRange(pos, pChunk, n);
+		}
+		for (abi_size_t i=0; i<n; ++i) {
+			if (!rThis.abiInsert(pos + i, pChunk[i])) {
+				(void)rThis.abiRemove(pos, i);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static void pointToElements(const T* pData, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer* pChunk, lia::detail::BoolType<true>) lia_NOEXCEPT {
+		for (abi_size_t i=0; i<n; ++i) {
+			assignElemPtr(pChunk[i], pData[i]);
+		}
+	}
+
+	static void pointToElements(const T*, abi_size_t, typename lia::detail::MakeTypes<T>::ConstPointer*, lia::detail::BoolType<false>) lia_NOEXCEPT {
+	}
+
+	template<typename U, typename V>
+	static void copyToImpl(const TInterface& rThis, std::vector<U, V>& v, lia::detail::BoolType<true>) {
+		const T* pData = lia_NULLPTR;
+		abi_size_t sz = 0;
+		if (hasIVectorVersion(rThis, 3) && rThis.abiGetDataConst(pData, &sz)) {
+			v.assign(pData, pData + sz);
+		}
+		else {
+			copyToImpl(rThis, v, lia::detail::BoolType<false>());
+		}
+	}
+
+	template<typename U, typename V>
+	static void copyToImpl(const TInterface& rThis, std::vector<U, V>& v, lia::detail::BoolType<false>) {
+		const abi_size_t sz = rThis.abiGetSize();
+		v.reserve(static_cast<std::size_t>(sz));
+		const bool hasGetRange = hasIVectorVersion(rThis, 4);
+		typename lia::detail::MakeTypes<T>::ConstPointer chunk[kChunkSize];
+		for (abi_size_t i=0; i<sz; i += kChunkSize) {
+			const abi_size_t n = std::min<abi_size_t>(kChunkSize, sz - i);
+			if (!fetchChunk(rThis, i, n, chunk, hasGetRange)) {
+				lia_THROW1(std::out_of_range, "in copy of vector");
+			}
+			for (abi_size_t j=0; j<n; ++j) {
+				v.push_back(derefElemPtr(chunk[j]));
+			}
+		}
+	}
+
+	template<typename TFunc>
+	static void forEachImpl(const TInterface& rThis, TFunc& func, lia::detail::BoolType<true>) {
+		const T* pData = lia_NULLPTR;
+		abi_size_t sz = 0;
+		if (hasIVectorVersion(rThis, 3) && rThis.abiGetDataConst(pData, &sz)) {
+			for (abi_size_t i=0; i<sz; ++i) {
+				func(pData[i]);
+			}
+		}
+		else {
+			forEachImpl(rThis, func, lia::detail::BoolType<false>());
+		}
+	}
+
+	template<typename TFunc>
+	static void forEachImpl(const TInterface& rThis, TFunc& func, lia::detail::BoolType<false>) {
+		if (hasIVectorVersion(rThis, 9)) {
+			(void)visitChunksImpl(rThis, 0, npos(), ElementVisitor<TFunc>(func));
+			return;
+		}
+		const abi_size_t sz = rThis.abiGetSize();
+		const bool hasGetRange = hasIVectorVersion(rThis, 4);
+		typename lia::detail::MakeTypes<T>::ConstPointer chunk[kChunkSize];
+		for (abi_size_t i=0; i<sz; i += kChunkSize) {
+			const abi_size_t n = std::min<abi_size_t>(kChunkSize, sz - i);
+			if (!fetchChunk(rThis, i, n, chunk, hasGetRange)) {
+				lia_THROW1(std::out_of_range, "in forEach() call");
+			}
+			for (abi_size_t j=0; j<n; ++j) {
+				func(derefElemPtr(chunk[j]));
+			}
+		}
+	}
+
+	template<typename TFunc>
+	static void forEachImpl(TInterface& rThis, TFunc& func, lia::detail::BoolType<true>) {
+		T* pData = lia_NULLPTR;
+		abi_size_t sz = 0;
+		if (hasIVectorVersion(rThis, 3) && rThis.abiGetData(pData, &sz)) {
+			for (abi_size_t i=0; i<sz; ++i) {
+				func(pData[i]);
+			}
+		}
+		else {
+			forEachImpl(rThis, func, lia::detail::BoolType<false>());
+		}
+	}
+
+	template<typename TFunc>
+	static void forEachImpl(TInterface& rThis, TFunc& func, lia::detail::BoolType<false>) {
+		if (hasIVectorVersion(rThis, 9)) {
+			(void)visitChunksImpl(rThis, 0, npos(), ElementVisitor<TFunc>(func));
+			return;
+		}
+		const abi_size_t sz = rThis.abiGetSize();
+		const bool hasGetRange = hasIVectorVersion(rThis, 4);
+		typename lia::detail::MakeTypes<T>::Pointer chunk[kChunkSize];
+		for (abi_size_t i=0; i<sz; i += kChunkSize) {
+			const abi_size_t n = std::min<abi_size_t>(kChunkSize, sz - i);
+			if (!fetchChunk(rThis, i, n, chunk, hasGetRange)) {
+				lia_THROW1(std::out_of_range, "in forEach() call");
+			}
+			for (abi_size_t j=0; j<n; ++j) {
+				func(derefElemPtr(chunk[j]));
+			}
+		}
+	}
+
+	static std::size_t npos() lia_NOEXCEPT {
+		return static_cast<std::size_t>(-1);
+	}
+
+	template<typename TFunc>
+	static bool visitChunksImpl(const TInterface& rThis, std::size_t pos, std::size_t count, TFunc func) {
+		const std::size_t sz = static_cast<std::size_t>(rThis.abiGetSize());
+		if (pos > sz) {
+			lia_THROW1(std::out_of_range, "in visitChunks() call");
+		}
+		count = std::min(count, sz - pos);
+		if (hasIVectorVersion(rThis, 9)) {
+			VisitContext<TFunc> context(func);
+			const bool result = rThis.abiVisitConst(static_cast<abi_size_t>(pos), static_cast<abi_size_t>(count), &VisitContext<TFunc>::template call<typename lia::detail::VisitTypes<T>::ConstChunk>, &context);
+			context.rethrowIfFailed();
+			return result;
+		}
+		// Older implementations: Visit the elements in chunks fetched over the ABI boundary
+		const bool hasGetRange = hasIVectorVersion(rThis, 4);
+		typename lia::detail::MakeTypes<T>::ConstPointer chunk[kChunkSize];
+		for (std::size_t i=0; i<count; i += kChunkSize) {
+			const std::size_t n = std::min(kChunkSize, count - i);
+			if (!fetchChunk(rThis, static_cast<abi_size_t>(pos + i), static_cast<abi_size_t>(n), chunk, hasGetRange)) {
+				lia_THROW1(std::out_of_range, "in visitChunks() call");
+			}
+			if (!visitFetchedChunk(func, chunk, n, IsContiguousTag())) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename TFunc>
+	static bool visitChunksImpl(TInterface& rThis, std::size_t pos, std::size_t count, TFunc func) {
+		const std::size_t sz = static_cast<std::size_t>(rThis.abiGetSize());
+		if (pos > sz) {
+			lia_THROW1(std::out_of_range, "in visitChunks() call");
+		}
+		count = std::min(count, sz - pos);
+		if (hasIVectorVersion(rThis, 9)) {
+			VisitContext<TFunc> context(func);
+			const bool result = rThis.abiVisit(static_cast<abi_size_t>(pos), static_cast<abi_size_t>(count), &VisitContext<TFunc>::template call<typename lia::detail::VisitTypes<T>::Chunk>, &context);
+			context.rethrowIfFailed();
+			return result;
+		}
+		const bool hasGetRange = hasIVectorVersion(rThis, 4);
+		typename lia::detail::MakeTypes<T>::Pointer chunk[kChunkSize];
+		for (std::size_t i=0; i<count; i += kChunkSize) {
+			const std::size_t n = std::min(kChunkSize, count - i);
+			if (!fetchChunk(rThis, static_cast<abi_size_t>(pos + i), static_cast<abi_size_t>(n), chunk, hasGetRange)) {
+				lia_THROW1(std::out_of_range, "in visitChunks() call");
+			}
+			if (!visitFetchedChunk(func, chunk, n, IsContiguousTag())) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// The fetched pointers to contiguous elements don't necessarily point into one array, so
+	// they're passed one by one
+	template<typename TFunc, typename TElemPtr>
+	static bool visitFetchedChunk(TFunc& func, TElemPtr* pChunk, std::size_t n, lia::detail::BoolType<true>) {
+		for (std::size_t i=0; i<n; ++i) {
+			if (!func(pChunk[i], static_cast<std::size_t>(1u))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename TFunc, typename TElemPtr>
+	static bool visitFetchedChunk(TFunc& func, TElemPtr* pChunk, std::size_t n, lia::detail::BoolType<false>) {
+		return func(pChunk, n);
+	}
+
+	static bool fetchChunk(const TInterface& rThis, abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::ConstPointer* pChunk, bool hasGetRange) lia_NOEXCEPT {
+		if (hasGetRange) {
+			return rThis.abiGetRangeConst(idx, n, pChunk);
+		}
+		for (abi_size_t i=0; i<n; ++i) {
+			if (!rThis.abiGetAtConst(idx + i, pChunk[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool fetchChunk(TInterface& rThis, abi_size_t idx, abi_size_t n, typename lia::detail::MakeTypes<T>::Pointer* pChunk, bool hasGetRange) lia_NOEXCEPT {
+		if (hasGetRange) {
+			return rThis.abiGetRange(idx, n, pChunk);
+		}
+		for (abi_size_t i=0; i<n; ++i) {
+			if (!rThis.abiGetAt(idx + i, pChunk[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool isEqual(const TInterface& a, const TInterface& b, lia::detail::BoolType<true>) {
+		const T* pA = lia_NULLPTR;
+		const T* pB = lia_NULLPTR;
+		abi_size_t sizeA = 0;
+		abi_size_t sizeB = 0;
+		if (hasIVectorVersion(a, 3) && hasIVectorVersion(b, 3) && a.abiGetDataConst(pA, &sizeA) && b.abiGetDataConst(pB, &sizeB)) {
+			if (sizeA != sizeB) {
+				return false;
+			}
+			if (lia::detail::IsBitwiseComparable<T>::value) {
+				return (sizeA == 0) || (std::memcmp(pA, pB, static_cast<std::size_t>(sizeA) * sizeof(T)) == 0);
+			}
+			return std::equal(pA, pA + sizeA, pB);
+		}
+		return isEqual(a, b, lia::detail::BoolType<false>());
+	}
+
+	static bool isEqual(const TInterface& a, const TInterface& b, lia::detail::BoolType<false>) {
+		const abi_size_t size = a.abiGetSize();
+		if (&a == &b) {
+			return true;
+		}
+		if (size != b.abiGetSize()) {
+			return false;
+		}
+		const bool hasGetRangeA = hasIVectorVersion(a, 4);
+		const bool hasGetRangeB = hasIVectorVersion(b, 4);
+		typename lia::detail::MakeTypes<T>::ConstPointer chunkA[kChunkSize];
+		typename lia::detail::MakeTypes<T>::ConstPointer chunkB[kChunkSize];
+		for (abi_size_t i=0; i<size; i += kChunkSize) {
+			const abi_size_t n = std::min<abi_size_t>(kChunkSize, size - i);
+			if (!fetchChunk(a, i, n, chunkA, hasGetRangeA) || !fetchChunk(b, i, n, chunkB, hasGetRangeB)) {
+				lia_THROW1(std::out_of_range, "in comparison");
+			}
+			for (abi_size_t j=0; j<n; ++j) {
+				if (!(derefElemPtr(chunkA[j]) == derefElemPtr(chunkB[j]))) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	static bool isLess(const TInterface& a, const TInterface& b, lia::detail::BoolType<true>) {
+		const T* pA = lia_NULLPTR;
+		const T* pB = lia_NULLPTR;
+		abi_size_t sizeA = 0;
+		abi_size_t sizeB = 0;
+		if (hasIVectorVersion(a, 3) && hasIVectorVersion(b, 3) && a.abiGetDataConst(pA, &sizeA) && b.abiGetDataConst(pB, &sizeB)) {
+			return std::lexicographical_compare(pA, pA + sizeA, pB, pB + sizeB);
+		}
+		return isLess(a, b, lia::detail::BoolType<false>());
+	}
+
+	static bool isLess(const TInterface& a, const TInterface& b, lia::detail::BoolType<false>) {
+		const abi_size_t sizeA = a.abiGetSize();
+		const abi_size_t sizeB = b.abiGetSize();
+		const abi_size_t size  = std::min(sizeA, sizeB);
+		const bool hasGetRangeA = hasIVectorVersion(a, 4);
+		const bool hasGetRangeB = hasIVectorVersion(b, 4);
+		typename lia::detail::MakeTypes<T>::ConstPointer chunkA[kChunkSize];
+		typename lia::detail::MakeTypes<T>::ConstPointer chunkB[kChunkSize];
+		for (abi_size_t i=0; i<size; i += kChunkSize) {
+			const abi_size_t n = std::min<abi_size_t>(kChunkSize, size - i);
+			if (!fetchChunk(a, i, n, chunkA, hasGetRangeA) || !fetchChunk(b, i, n, chunkB, hasGetRangeB)) {
+				lia_THROW1(std::out_of_range, "in comparison");
+			}
+			for (abi_size_t j=0; j<n; ++j) {
+				if (derefElemPtr(chunkA[j]) < derefElemPtr(chunkB[j])) {
+					return true;
+				}
+				if (derefElemPtr(chunkB[j]) < derefElemPtr(chunkA[j])) {
+					return false;
+				}
+			}
+		}
+		return (sizeA < sizeB);
+	}
+
+#if lia_CPP11_API
+
+	// Hashes the bytes of all elements as if they were one block of memory, also when they're fetched in chunks
+	static uint64_t hashImpl(const TInterface& rThis, abi_size_t size, uint64_t h, lia::detail::BoolType<true>) {
+		const T* pData = lia_NULLPTR;
+		if (hasIVectorVersion(rThis, 3) && rThis.abiGetDataConst(pData)) {
+			return lia::detail::hashBytes(h, pData, static_cast<std::size_t>(size) * sizeof(T));
+		}
+		const bool hasGetRange = hasIVectorVersion(rThis, 4);
+		typename lia::detail::MakeTypes<T>::ConstPointer chunk[kChunkSize];
+		unsigned char bytes[kChunkSize * sizeof(T)]; // a multiple of 8 bytes, see hashBytes()
+		for (abi_size_t i=0; i<size; i += kChunkSize) {
+			const abi_size_t n = std::min<abi_size_t>(kChunkSize, size - i);
+			if (!fetchChunk(rThis, i, n, chunk, hasGetRange)) {
+				lia_THROW1(std::out_of_range, "in hashValue() call");
+			}
+			for (abi_size_t j=0; j<n; ++j) {
+				std::memcpy(bytes + j * sizeof(T), chunk[j], sizeof(T));
+			}
+			h = lia::detail::hashBytes(h, bytes, static_cast<std::size_t>(n) * sizeof(T));
+		}
+		return h;
+	}
+
+	static uint64_t hashImpl(const TInterface& rThis, abi_size_t size, uint64_t h, lia::detail::BoolType<false>) {
+		const bool hasGetRange = hasIVectorVersion(rThis, 4);
+		typename lia::detail::MakeTypes<T>::ConstPointer chunk[kChunkSize];
+		for (abi_size_t i=0; i<size; i += kChunkSize) {
+			const abi_size_t n = std::min<abi_size_t>(kChunkSize, size - i);
+			if (!fetchChunk(rThis, i, n, chunk, hasGetRange)) {
+				lia_THROW1(std::out_of_range, "in hashValue() call");
+			}
+			for (abi_size_t j=0; j<n; ++j) {
+				h = lia::detail::hashCombine(h, static_cast<uint64_t>(hashElement(derefElemPtr(chunk[j]))));
+			}
+		}
+		return h;
+	}
+
+	template<typename U>
+	static std::size_t hashElement(const U& elem) {
+		return std::hash<U>()(elem);
+	}
+
+	template<typename U>
+	static std::size_t hashElement(const lia::detail::VectorProxy<U>& elem) {
+		return elem.hashValue();
+	}
+
+#endif
+
+	static uint32_t getCapabilities(const TInterface& rThis) lia_NOEXCEPT {
+		InterfaceVersion v;
+		rThis.abiGetIVectorVersion(v);
+		if (v.major != 0) {
+			return 0u;
+		}
+		if (v.minor >= 12) {
+			return rThis.abiGetCapabilities(lia_TOOLCHAIN_ID);
+		}
+		uint32_t caps = 0u;
+		if (v.minor >= 2) {
+			caps |= kCapBulkInsert;
+		}
+		if ((v.minor >= 3) && IsContiguousTag::value) {
+			caps |= kCapContiguousStorage;
+		}
+		if (v.minor >= 9) {
+			caps |= kCapNativeAlgorithms;
+		}
+		return caps;
+	}
+
+	template<typename TLess>
+	void sortImpl(uint32_t algorithm, std::size_t middle, TLess less, std::size_t numThreads) {
+		TInterface& rThis = downCast().getAbi();
+		if (middle > static_cast<std::size_t>(rThis.abiGetSize())) {
+			lia_THROW1(std::out_of_range, "in sort() call");
+		}
+		if (numThreads == 0u) {
+#if lia_CPP11_API
+			numThreads = std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), static_cast<std::size_t>(1u));
+#else
+			numThreads = 1u;
+#endif
+		}
+		if (sortInStorage(rThis, algorithm, middle, less, numThreads, IsContiguousTag())) {
+			return;
+		}
+		if (!hasIVectorVersion(rThis, 15)) {
+			lia_THROW1(std::logic_error, "sort() not supported by IVector implementation");
+		}
+		sortByOwner(rThis, algorithm, middle, less, static_cast<uint32_t>(std::min(numThreads, static_cast<std::size_t>(0xFFFFFFFFu))));
+	}
+
+	// Sorting in the storage of the vector lets the compiler inline the comparisons
+	template<typename TLess>
+	static bool sortInStorage(TInterface& rThis, uint32_t algorithm, std::size_t middle, TLess& less, std::size_t numThreads, lia::detail::BoolType<true>) {
+		T* pData = lia_NULLPTR;
+		abi_size_t size = 0;
+		if (!hasIVectorVersion(rThis, 3) || !rThis.abiGetData(pData, &size)) {
+			return false;
+		}
+		lia::detail::runSortAlgorithm(pData, pData + size, algorithm, middle, less, numThreads);
+		return true;
+	}
+
+	template<typename TLess>
+	static bool sortInStorage(TInterface&, uint32_t, std::size_t, TLess&, std::size_t, lia::detail::BoolType<false>) {
+		return false;
+	}
+
+	// Without a comparator, the owning module compares with operator< and doesn't need to call back
+	static void sortByOwner(TInterface& rThis, uint32_t algorithm, std::size_t middle, lia::detail::DefaultLess&, uint32_t numThreads) {
+		if (!rThis.abiSort(algorithm, static_cast<abi_size_t>(middle), lia_NULLPTR, lia_NULLPTR, numThreads)) {
+			lia_THROW0(std::bad_alloc);
+		}
+	}
+
+	template<typename TLess>
+	static void sortByOwner(TInterface& rThis, uint32_t algorithm, std::size_t middle, TLess& less, uint32_t numThreads) {
+		lia::detail::CallbackContext<TLess> context(less);
+		const bool result = rThis.abiSort(algorithm, static_cast<abi_size_t>(middle), &lia::detail::CallbackContext<TLess>::template compare<typename lia::detail::MakeTypes<T>::ConstPointer>, &context, numThreads);
+		context.rethrowIfFailed();
+		if (!result) {
+			lia_THROW0(std::bad_alloc);
+		}
+	}
+
+	template<typename TEqual>
+	std::size_t uniqueImpl(TEqual equal) {
+		TInterface& rThis = downCast().getAbi();
+		std::size_t numRemoved = 0u;
+		if (uniqueInStorage(rThis, equal, numRemoved, IsContiguousTag())) {
+			return numRemoved;
+		}
+		lia::detail::CallbackContext<TEqual> context(equal);
+		const bool isOk = uniqueWithCallback(rThis, context, equal, numRemoved);
+		context.rethrowIfFailed();
+		if (!isOk) {
+			lia_THROW0(std::bad_alloc);
+		}
+		return numRemoved;
+	}
+
+	// Erases the elements [newEnd, end) that were left over by compacting the elements before end in the storage of the vector
+	static void eraseTailImpl(TInterface& rThis, std::size_t newEnd, std::size_t end, std::size_t& numRemoved) {
+		if ((newEnd < end) && !rThis.abiRemove(static_cast<abi_size_t>(newEnd), static_cast<abi_size_t>(end - newEnd))) {
+			lia_THROW1(std::out_of_range, "in erase() call");
+		}
+		numRemoved = end - newEnd;
+	}
+
+	// Elements of types other than lia interfaces are compacted directly in the storage of the vector
+	template<typename TPred>
+	static bool eraseIfInStorage(TInterface& rThis, TPred& pred, std::size_t& numRemoved, lia::detail::BoolType<true>) {
+		T* pData = lia_NULLPTR;
+		abi_size_t size = 0;
+		if (!hasIVectorVersion(rThis, 3) || !rThis.abiGetData(pData, &size)) {
+			return false;
+		}
+		eraseTailImpl(rThis, static_cast<std::size_t>(std::remove_if(pData, pData + size, pred) - pData), static_cast<std::size_t>(size), numRemoved);
+		return true;
+	}
+
+	template<typename TPred>
+	static bool eraseIfInStorage(TInterface&, TPred&, std::size_t&, lia::detail::BoolType<false>) {
+		return false;
+	}
+
+	template<typename TEqual>
+	static bool uniqueInStorage(TInterface& rThis, TEqual& equal, std::size_t& numRemoved, lia::detail::BoolType<true>) {
+		T* pData = lia_NULLPTR;
+		abi_size_t size = 0;
+		if (!hasIVectorVersion(rThis, 3) || !rThis.abiGetData(pData, &size)) {
+			return false;
+		}
+		eraseTailImpl(rThis, static_cast<std::size_t>(std::unique(pData, pData + size, equal) - pData), static_cast<std::size_t>(size), numRemoved);
+		return true;
+	}
+
+	template<typename TEqual>
+	static bool uniqueInStorage(TInterface&, TEqual&, std::size_t&, lia::detail::BoolType<false>) {
+		return false;
+	}
+
+	static bool keepMaskedInStorage(TInterface& rThis, const uint8_t* pMask, std::size_t maskSize, uint32_t maskFormat, std::size_t& numRemoved, lia::detail::BoolType<true>) {
+		T* pData = lia_NULLPTR;
+		abi_size_t size = 0;
+		if (!hasIVectorVersion(rThis, 3) || !rThis.abiGetData(pData, &size)) {
+			return false;
+		}
+		if (!lia::detail::coversElements(maskSize, maskFormat, static_cast<std::size_t>(size))) {
+			lia_THROW1(std::invalid_argument, "in keepMasked() call");
+		}
+		eraseTailImpl(rThis, lia::detail::compactIndices(pData, 0u, static_cast<std::size_t>(size), lia::detail::MaskedOut(pMask, maskFormat)), static_cast<std::size_t>(size), numRemoved);
+		return true;
+	}
+
+	static bool keepMaskedInStorage(TInterface&, const uint8_t*, std::size_t, uint32_t, std::size_t&, lia::detail::BoolType<false>) {
+		return false;
+	}
+
+	// Removes the elements that the predicate behind pPred is true for in the owning module, or with removeRunsFallback()
+	template<typename TContext>
+	static bool removeWithCallback(TInterface& rThis, TContext& context, typename lia::detail::PredicateTypes<T>::Function pPred, std::size_t& numRemoved) {
+		const std::size_t size = static_cast<std::size_t>(rThis.abiGetSize());
+		if (hasIVectorVersion(rThis, 18)) {
+			abi_size_t num = 0;
+			const bool isOk = rThis.abiRemoveIf(0, static_cast<abi_size_t>(size), pPred, &context, &num);
+			numRemoved = static_cast<std::size_t>(num);
+			return isOk;
+		}
+		lia_TRY
+			numRemoved = removeRunsFallback(rThis, size, lia::detail::ElementOf< TInterface, lia::detail::CallbackPredicate<T> >(rThis, lia::detail::CallbackPredicate<T>(pPred, &context)));
+		lia_CATCHALL(return false)
+		return true;
+	}
+
+	// Without a predicate for equality, the owning module compares with operator== and doesn't need to call back
+	template<typename TContext>
+	static bool uniqueWithCallback(TInterface& rThis, TContext&, lia::detail::DefaultEqual&, std::size_t& numRemoved) {
+		const std::size_t size = static_cast<std::size_t>(rThis.abiGetSize());
+		if (hasIVectorVersion(rThis, 18)) {
+			abi_size_t num = 0;
+			const bool isOk = rThis.abiUnique(0, static_cast<abi_size_t>(size), lia_NULLPTR, lia_NULLPTR, &num);
+			numRemoved = static_cast<std::size_t>(num);
+			return isOk;
+		}
+		numRemoved = removeRunsFallback(rThis, size, lia::detail::EqualToPrevious< TInterface, lia::detail::PointerEqual<T> >(rThis, lia::detail::PointerEqual<T>()));
+		return true;
+	}
+
+	template<typename TContext, typename TEqual>
+	static bool uniqueWithCallback(TInterface& rThis, TContext& context, TEqual&, std::size_t& numRemoved) {
+		const typename lia::detail::CompareTypes<T>::Function pEqual = &TContext::template compare<TConstPointer>;
+		const std::size_t size = static_cast<std::size_t>(rThis.abiGetSize());
+		if (hasIVectorVersion(rThis, 18)) {
+			abi_size_t num = 0;
+			const bool isOk = rThis.abiUnique(0, static_cast<abi_size_t>(size), pEqual, &context, &num);
+			numRemoved = static_cast<std::size_t>(num);
+			return isOk;
+		}
+		lia_TRY
+			numRemoved = removeRunsFallback(rThis, size, lia::detail::EqualToPrevious< TInterface, lia::detail::CallbackPointerCompare<T> >(rThis, lia::detail::CallbackPointerCompare<T>(pEqual, &context)));
+		lia_CATCHALL(return false)
+		return true;
+	}
+
+	// For implementations before version 0.18: Removes the runs of consecutive elements that remove(index) is true for,
+	// starting at the back so that the indices of the elements that are still to be checked don't change. That's one
+	// abiRemove() per run.
+	template<typename TRemove>
+	static std::size_t removeRunsFallback(TInterface& rThis, std::size_t size, TRemove remove) {
+		std::size_t numRemoved = 0u;
+		std::size_t end = size;
+		while (end > 0u) {
+			if (!remove(end - 1u)) {
+				--end;
+				continue;
+			}
+			std::size_t first = end - 1u;
+			while ((first > 0u) && remove(first - 1u)) {
+				--first;
+			}
+			if (!rThis.abiRemove(static_cast<abi_size_t>(first), static_cast<abi_size_t>(end - first))) {
+				lia_THROW1(std::out_of_range, "in erase() call");
+			}
+			numRemoved += end - first;
+			end = first;
+		}
+		return numRemoved;
+	}
+
+	template<typename U>
+	static bool gatherInStorage(const TInterface& rThis, const abi_size_t* pIndices, std::size_t n, U* pOut, lia::detail::BoolType<true>) {
+		const T* pData = lia_NULLPTR;
+		abi_size_t size = 0;
+		if (!hasIVectorVersion(rThis, 3) || !rThis.abiGetDataConst(pData, &size)) {
+			return false;
+		}
+		if (!lia::detail::areValidIndices(pIndices, n, static_cast<std::size_t>(size))) {
+			lia_THROW1(std::out_of_range, "in gather() call");
+		}
+		lia::detail::gatherValues(pData, pIndices, n, pOut);
+		return true;
+	}
+
+	template<typename U>
+	static bool gatherInStorage(const TInterface&, const abi_size_t*, std::size_t, U*, lia::detail::BoolType<false>) {
+		return false;
+	}
+
+	// Fetches the pointers to the elements in chunks, with one abiGatherConst() per chunk or one abiGetAtConst() per
+	// element for implementations before version 0.19
+	template<typename U>
+	static void gatherByOwner(const TInterface& rThis, const abi_size_t* pIndices, std::size_t n, U* pOut) {
+		if (!lia::detail::areValidIndices(pIndices, n, static_cast<std::size_t>(rThis.abiGetSize()))) {
+			lia_THROW1(std::out_of_range, "in gather() call");
+		}
+		const bool hasGather = hasIVectorVersion(rThis, 19);
+		typename lia::detail::MakeTypes<T>::ConstPointer chunk[kChunkSize];
+		for (std::size_t i=0; i<n; i += kChunkSize) {
+			const std::size_t num = std::min(kChunkSize, n - i);
+			if (hasGather) {
+				if (!rThis.abiGatherConst(pIndices + i, static_cast<abi_size_t>(num), chunk)) {
+					lia_THROW1(std::out_of_range, "in gather() call");
+				}
+			}
+			else {
+				for (std::size_t j=0; j<num; ++j) {
+					if (!rThis.abiGetAtConst(pIndices[i + j], chunk[j])) {
+						lia_THROW1(std::out_of_range, "in gather() call");
+					}
+				}
+			}
+			for (std::size_t j=0; j<num; ++j) {
+				pOut[i + j] = derefElemPtr(chunk[j]);
+			}
+		}
+	}
+
+	template<typename U>
+	static bool scatterInStorage(TInterface& rThis, const abi_size_t* pIndices, std::size_t n, const U* pValues, lia::detail::BoolType<true>) {
+		T* pData = lia_NULLPTR;
+		abi_size_t size = 0;
+		if (!hasIVectorVersion(rThis, 3) || !rThis.abiGetData(pData, &size)) {
+			return false;
+		}
+		if (!lia::detail::areValidIndices(pIndices, n, static_cast<std::size_t>(size))) {
+			lia_THROW1(std::out_of_range, "in scatter() call");
+		}
+		lia::detail::scatterValues(pData, pIndices, n, pValues);
+		return true;
+	}
+
+	template<typename U>
+	static bool scatterInStorage(TInterface&, const abi_size_t*, std::size_t, const U*, lia::detail::BoolType<false>) {
+		return false;
+	}
+
+	// Passes pointers to the values in chunks, with one abiScatter() per chunk or one abiGetAt() per element for
+	// implementations before version 0.19
+	template<typename U>
+	static void scatterByOwner(TInterface& rThis, const abi_size_t* pIndices, std::size_t n, const U* pValues) {
+		if (!lia::detail::areValidIndices(pIndices, n, static_cast<std::size_t>(rThis.abiGetSize()))) {
+			lia_THROW1(std::out_of_range, "in scatter() call");
+		}
+		if (!hasIVectorVersion(rThis, 19)) {
+			for (std::size_t i=0; i<n; ++i) {
+				typename lia::detail::MakeTypes<T>::Pointer pElem;
+				if (!rThis.abiGetAt(pIndices[i], pElem)) {
+					lia_THROW1(std::out_of_range, "in scatter() call");
+				}
+				derefElemPtr(pElem) = pValues[i];
+			}
+			return;
+		}
+		typename lia::detail::MakeTypes<T>::ConstPointer chunk[kChunkSize];
+		for (std::size_t i=0; i<n; i += kChunkSize) {
+			const std::size_t num = std::min(kChunkSize, n - i);
+			for (std::size_t j=0; j<num; ++j) {
+				assignElemPtr(chunk[j], pValues[i + j]);
+			}
+			if (!rThis.abiScatter(pIndices + i, static_cast<abi_size_t>(num), chunk)) {
+				lia_THROW1(std::out_of_range, "in scatter() call");
+			}
+		}
+	}
+
+	// Runs a kReduce... operation on all elements, with *pOther being the second vector for kReduceDot. The elements
+	// are reduced in their storage if possible, otherwise by the owning module, and as a last resort as copies.
+	void reduceImpl(uint32_t operation, const TInterface* pOther, void* pResult) const {
+		typedef typename lia::detail::RemoveConst<T>::type TNonConst;
+		const TInterface& rThis = downCast().getAbi();
+		const abi_size_t size = rThis.abiGetSize();
+		if ((pOther != lia_NULLPTR) && (pOther->abiGetSize() != size)) {
+			lia_THROW1(std::invalid_argument, "in dot() call");
+		}
+		if ((size == 0) && ((operation == kReduceMin) || (operation == kReduceMax))) {
+			lia_THROW1(std::out_of_range, "in minValue() or maxValue() call");
+		}
+		const T* pData = lia_NULLPTR;
+		const T* pOtherData = lia_NULLPTR;
+		const bool isContiguous = hasIVectorVersion(rThis, 3) && rThis.abiGetDataConst(pData);
+		const bool isOtherContiguous = (pOther == lia_NULLPTR) || (hasIVectorVersion(*pOther, 3) && pOther->abiGetDataConst(pOtherData));
+		if (isContiguous && isOtherContiguous) {
+			(void)lia::detail::ReduceRange<true>::reduce(pData, static_cast<std::size_t>(size), operation, pOtherData, pResult);
+		}
+		else if (!lia::detail::ReduceTypes<TNonConst>::isAbiFixed || !hasIVectorVersion(rThis, 17) || !rThis.abiReduce(operation, 0, size, pOther, pResult)) {
+			std::vector<TNonConst> values;
+			std::vector<TNonConst> otherValues;
+			copyToImpl(rThis, values, IsContiguousTag());
+			if (pOther != lia_NULLPTR) {
+				copyToImpl(*pOther, otherValues, IsContiguousTag());
+			}
+			(void)lia::detail::ReduceRange<true>::reduce(values.empty() ? lia_NULLPTR : &values[0], values.size(), operation, otherValues.empty() ? lia_NULLPTR : &otherValues[0], pResult);
+		}
+	}
+
+	// Runs kSearchFind or kSearchCount on the elements [pos, size()) with operator==
+	template<typename TValue>
+	std::size_t scanForValue(uint32_t algorithm, std::size_t pos, const TValue& value) const {
+		const TInterface& rThis = downCast().getAbi();
+		const std::size_t size = static_cast<std::size_t>(rThis.abiGetSize());
+		if (pos >= size) {
+			return (algorithm == kSearchFind) ? size : 0u;
+		}
+		typename lia::detail::MakeTypes<T>::ConstPointer pValue;
+		assignElemPtr(pValue, value);
+		std::size_t result = 0u;
+		if (scanValueInStorage(rThis, algorithm, pos, size, pValue, result, IsContiguousTag())) {
+			return result;
+		}
+		if (hasIVectorVersion(rThis, 16)) {
+			abi_size_t found = 0;
+			if (!rThis.abiFind(algorithm, static_cast<abi_size_t>(pos), static_cast<abi_size_t>(size - pos), pValue, lia_NULLPTR, lia_NULLPTR, &found)) {
+				lia_THROW0(std::bad_alloc);
+			}
+			return static_cast<std::size_t>(found);
+		}
+		return scanFallback(rThis, algorithm, pos, size, lia::detail::EqualsValue<T>(pValue));
+	}
+
+	// Runs kSearchFind or kSearchCount on the elements [pos, size()) with a predicate of the caller
+	template<typename TPred>
+	std::size_t scanIf(uint32_t algorithm, std::size_t pos, TPred& pred) const {
+		const TInterface& rThis = downCast().getAbi();
+		const std::size_t size = static_cast<std::size_t>(rThis.abiGetSize());
+		if (pos >= size) {
+			return (algorithm == kSearchFind) ? size : 0u;
+		}
+		std::size_t result = 0u;
+		if (scanIfInStorage(rThis, algorithm, pos, size, pred, result, IsContiguousTag())) {
+			return result;
+		}
+		lia::detail::CallbackContext<TPred> context(pred);
+		bool isOk = true;
+		if (hasIVectorVersion(rThis, 16)) {
+			TConstPointer pUnused = TConstPointer();
+			abi_size_t found = 0;
+			isOk = rThis.abiFind(algorithm, static_cast<abi_size_t>(pos), static_cast<abi_size_t>(size - pos), pUnused, &lia::detail::CallbackContext<TPred>::template test<TConstPointer>, &context, &found);
+			result = static_cast<std::size_t>(found);
+		}
+		else {
+			lia_TRY
+				result = scanFallback(rThis, algorithm, pos, size, lia::detail::CallbackPredicate<T>(&lia::detail::CallbackContext<TPred>::template test<TConstPointer>, &context));
+			lia_CATCHALL(isOk = false)
+		}
+		context.rethrowIfFailed();
+		if (!isOk) {
+			lia_THROW0(std::bad_alloc);
+		}
+		return result;
+	}
+
+	// Elements of types other than lia interfaces are searched directly in the storage of the vector
+	static bool scanValueInStorage(const TInterface& rThis, uint32_t algorithm, std::size_t pos, std::size_t size, const T* pValue, std::size_t& result, lia::detail::BoolType<true>) {
+		const T* pData = lia_NULLPTR;
+		if (!hasIVectorVersion(rThis, 3) || !rThis.abiGetDataConst(pData)) {
+			return false;
+		}
+		if (algorithm == kSearchFind) {
+			result = pos + lia::detail::findValue(pData + pos, size - pos, *pValue);
+		}
+		else {
+			result = lia::detail::countValue(pData + pos, size - pos, *pValue);
+		}
+		return true;
+	}
+
+	static bool scanValueInStorage(const TInterface&, uint32_t, std::size_t, std::size_t, TConstPointer&, std::size_t&, lia::detail::BoolType<false>) {
+		return false;
+	}
+
+	template<typename TPred>
+	static bool scanIfInStorage(const TInterface& rThis, uint32_t algorithm, std::size_t pos, std::size_t size, TPred& pred, std::size_t& result, lia::detail::BoolType<true>) {
+		const T* pData = lia_NULLPTR;
+		if (!hasIVectorVersion(rThis, 3) || !rThis.abiGetDataConst(pData)) {
+			return false;
+		}
+		if (algorithm == kSearchFind) {
+			result = static_cast<std::size_t>(std::find_if(pData + pos, pData + size, pred) - pData);
+		}
+		else {
+			result = static_cast<std::size_t>(std::count_if(pData + pos, pData + size, pred));
+		}
+		return true;
+	}
+
+	template<typename TPred>
+	static bool scanIfInStorage(const TInterface&, uint32_t, std::size_t, std::size_t, TPred&, std::size_t&, lia::detail::BoolType<false>) {
+		return false;
+	}
+
+	// For implementations before version 0.16: Fetches the elements in chunks and applies pred to the element pointers
+	template<typename TPtrPred>
+	static std::size_t scanFallback(const TInterface& rThis, uint32_t algorithm, std::size_t pos, std::size_t size, TPtrPred pred) {
+		const bool hasGetRange = hasIVectorVersion(rThis, 4);
+		typename lia::detail::MakeTypes<T>::ConstPointer chunk[kChunkSize];
+		std::size_t result = 0u;
+		for (std::size_t i=pos; i<size; i += kChunkSize) {
+			const std::size_t n = std::min<std::size_t>(kChunkSize, size - i);
+			if (!fetchChunk(rThis, static_cast<abi_size_t>(i), static_cast<abi_size_t>(n), chunk, hasGetRange)) {
+				lia_THROW1(std::out_of_range, "in search");
+			}
+			for (std::size_t j=0; j<n; ++j) {
+				if (pred(chunk[j])) {
+					if (algorithm == kSearchFind) {
+						return i + j;
+					}
+					++result;
+				}
+			}
+		}
+		return (algorithm == kSearchFind) ? size : result;
+	}
+
+	// Runs kSearchLowerBound, kSearchUpperBound or kSearchEqualRange on the sorted elements
+	template<typename TValue, typename TLess>
+	std::pair<std::size_t, std::size_t> searchBoundsImpl(uint32_t algorithm, const TValue& value, TLess less) const {
+		const TInterface& rThis = downCast().getAbi();
+		const std::size_t size = static_cast<std::size_t>(rThis.abiGetSize());
+		typename lia::detail::MakeTypes<T>::ConstPointer pValue;
+		assignElemPtr(pValue, value);
+		abi_size_t result[2] = { 0, 0 };
+		if (!searchBoundsInStorage(rThis, algorithm, pValue, less, result, IsContiguousTag())) {
+			if (hasIVectorVersion(rThis, 16)) {
+				searchBoundsByOwner(rThis, algorithm, size, pValue, less, result);
+			}
+			else {
+				lia::detail::DerefLess<T, TLess> derefLess(less);
+				lia::detail::searchBounds(0u, size, algorithm,
+					lia::detail::ElementOf<TInterface, lia::detail::IsBeforeValue<T, lia::detail::DerefLess<T, TLess> > >(rThis, lia::detail::IsBeforeValue<T, lia::detail::DerefLess<T, TLess> >(pValue, derefLess)),
+					lia::detail::ElementOf<TInterface, lia::detail::IsNotAfterValue<T, lia::detail::DerefLess<T, TLess> > >(rThis, lia::detail::IsNotAfterValue<T, lia::detail::DerefLess<T, TLess> >(pValue, derefLess)), result);
+			}
+		}
+		return std::make_pair(static_cast<std::size_t>(result[0]), static_cast<std::size_t>(result[1]));
+	}
+
+	template<typename TLess>
+	static bool searchBoundsInStorage(const TInterface& rThis, uint32_t algorithm, const T* pValue, TLess& less, abi_size_t* pResult, lia::detail::BoolType<true>) {
+		const T* pData = lia_NULLPTR;
+		abi_size_t size = 0;
+		if (!hasIVectorVersion(rThis, 3) || !rThis.abiGetDataConst(pData, &size)) {
+			return false;
+		}
+		if (algorithm == kSearchUpperBound) {
+			pResult[0] = static_cast<abi_size_t>(std::upper_bound(pData, pData + size, *pValue, less) - pData);
+		}
+		else if (algorithm == kSearchLowerBound) {
+			pResult[0] = static_cast<abi_size_t>(std::lower_bound(pData, pData + size, *pValue, less) - pData);
+		}
+		else {
+			const std::pair<const T*, const T*> range = std::equal_range(pData, pData + size, *pValue, less);
+			pResult[0] = static_cast<abi_size_t>(range.first - pData);
+			pResult[1] = static_cast<abi_size_t>(range.second - pData);
+		}
+		return true;
+	}
+
+	template<typename TLess>
+	static bool searchBoundsInStorage(const TInterface&, uint32_t, TConstPointer&, TLess&, abi_size_t*, lia::detail::BoolType<false>) {
+		return false;
+	}
+
+	// Without a comparator, the owning module compares with operator< and doesn't need to call back
+	static void searchBoundsByOwner(const TInterface& rThis, uint32_t algorithm, std::size_t size, typename lia::detail::MakeTypes<T>::ConstPointer& pValue, lia::detail::DefaultLess&, abi_size_t* pResult) {
+		if (!rThis.abiBinarySearch(algorithm, 0, static_cast<abi_size_t>(size), pValue, lia_NULLPTR, lia_NULLPTR, pResult)) {
+			lia_THROW0(std::bad_alloc);
+		}
+	}
+
+	template<typename TLess>
+	static void searchBoundsByOwner(const TInterface& rThis, uint32_t algorithm, std::size_t size, typename lia::detail::MakeTypes<T>::ConstPointer& pValue, TLess& less, abi_size_t* pResult) {
+		lia::detail::CallbackContext<TLess> context(less);
+		const bool result = rThis.abiBinarySearch(algorithm, 0, static_cast<abi_size_t>(size), pValue, &lia::detail::CallbackContext<TLess>::template compare<typename lia::detail::MakeTypes<T>::ConstPointer>, &context, pResult);
+		context.rethrowIfFailed();
+		if (!result) {
+			lia_THROW0(std::bad_alloc);
+		}
+	}
+
+	// Inserts the n elements at pSrc at position pos by growing the vector and copying them into its storage with memcpy(),
+	// if the implementation allows that. Returns false if nothing was inserted and the caller has to take the general path.
+	static bool insertByMemcpy(TInterface& rThis, abi_size_t pos, const T* pSrc, abi_size_t n, lia::detail::BoolType<true>) lia_NOEXCEPT {
+		const uint32_t required = kCapContiguousStorage | kCapTriviallyRelocatable;
+		if ((getCapabilities(rThis) & required) != required) {
+			return false;
+		}
+		T* pData = lia_NULLPTR;
+		abi_size_t size = 0;
+		if (!rThis.abiGetData(pData, &size) || (pos > size)) {
+			return false;
+		}
+		// the storage might be reallocated, so the source must not be part of it
+		const std::less<const T*> less;
+		if (!less(pSrc, pData) && less(pSrc, pData + size)) {
+			return false;
+		}
+		if (!rThis.abiResize(size + n) || !rThis.abiGetData(pData)) {
+			return false;
+		}
+		std::memmove(pData + pos + n, pData + pos, static_cast<std::size_t>(size - pos) * sizeof(T));
+		std::memcpy(pData + pos, pSrc, static_cast<std::size_t>(n) * sizeof(T));
+		return true;
+	}
+
+	template<typename U>
+	static bool insertByMemcpy(TInterface&, abi_size_t, const U*, abi_size_t, lia::detail::BoolType<false>) lia_NOEXCEPT {
+		return false;
+	}
+
+	static bool hasIVectorVersion(const TInterface& rThis, uint32_t minor) lia_NOEXCEPT {
+		InterfaceVersion v;
+		rThis.abiGetIVectorVersion(v);
+		return (v.major == 0) && (v.minor >= minor);
 	}
 
 	iterator eraseImpl(std::ptrdiff_t distanceFromBegin, std::size_t n) {
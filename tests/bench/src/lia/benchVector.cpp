@@ -0,0 +1,339 @@
+/*
++-----------------------------------+
+|                                   |
+|                 A                 |
+|                A A                |
+|               A   A               |
+|              A     A              |
+|  #  AAAAAAAAAAAAAAAAAAAAAAAAA  #  |
+|  ###       A         A       ###  |
+|  ######   A           A    #####  |
+|  ####### A             A #######  |
+|                                   |
++-----------------------------------+
+
+L I B A C R O S S - Using C++ containers
+ across DLL- and ABI-stable boundaries
+
+If you like this project, please refer to it with a link or
+some other reference. You can use this ASCII art icon as well
+as the supplied graphical icons for that purpose.
+
+(c) Copyright 2019 Jens Ganter-Benzing
+
+Licensed under the MIT license:
+
+http://www.opensource.org/licenses/mit-license.php
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <lia/DllLoader.h>
+#include <lia/IVector.h>
+
+using namespace lia::dll_loader;
+using namespace lia;
+using namespace std;
+
+// Each benchmark exists twice: a "Native" variant using std::vector directly and an
+// "IVector" variant using a vector created inside the test DLL. If more than one DLL is
+// passed with '--dll=', the vectors of the first one are used.
+
+namespace {
+
+typedef IVector<int32_t>* (lia_CALL *CreateInt32VectorFunction)(void);
+typedef IVector<IVector<int32_t>>* (lia_CALL *CreateInt32VectorVectorFunction)(void);
+
+const int64_t kSizes[]       = { 16, 256, 4096, 65536, 1048576, 16777216, 100000000 };
+const int64_t kNestedSizes[] = { 16, 256, 4096, 65536, 1048576 };
+const size_t  kInnerSize     = 8u; // size of each inner vector in the nested benchmarks
+
+unique_ptr<IVector<int32_t>> createInt32Vector() {
+	static const auto creators = getDllFunctions<CreateInt32VectorFunction>("createInt32Vector");
+	return unique_ptr<IVector<int32_t>>(creators.empty() ? nullptr : (*creators.front())());
+}
+
+unique_ptr<IVector<IVector<int32_t>>> createInt32VectorVector() {
+	static const auto creators = getDllFunctions<CreateInt32VectorVectorFunction>("createInt32VectorVector");
+	return unique_ptr<IVector<IVector<int32_t>>>(creators.empty() ? nullptr : (*creators.front())());
+}
+
+// Marks the benchmark as failed if no test DLL with the creator functions was passed, and returns whether pVector is usable
+template<typename TPointer>
+bool checkVector(benchmark::State& state, const TPointer& pVector) {
+	if (!pVector) {
+		state.SkipWithError("no test DLL passed with '--dll='");
+		return false;
+	}
+	return true;
+}
+
+void applySizes(benchmark::internal::Benchmark* pBenchmark) {
+	for (const auto size: kSizes) {
+		pBenchmark->Arg(size);
+	}
+}
+
+void applyNestedSizes(benchmark::internal::Benchmark* pBenchmark) {
+	for (const auto size: kNestedSizes) {
+		pBenchmark->Arg(size);
+	}
+}
+
+vector<int32_t> makeSource(size_t size) {
+	vector<int32_t> result(size);
+	for (size_t i=0; i<size; ++i) {
+		result[i] = static_cast<int32_t>(i);
+	}
+	return result;
+}
+
+void setItemsProcessed(benchmark::State& state, int64_t itemsPerIteration) {
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * itemsPerIteration);
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * itemsPerIteration * static_cast<int64_t>(sizeof(int32_t)));
+}
+
+// ---------------------------------------------------------------------------------------
+// push_back() into an empty vector
+
+void pushBackNative(benchmark::State& state) {
+	const size_t size = static_cast<size_t>(state.range(0));
+	for (auto _: state) {
+		vector<int32_t> v;
+		for (size_t i=0; i<size; ++i) {
+			v.push_back(static_cast<int32_t>(i));
+		}
+		benchmark::DoNotOptimize(v.data());
+	}
+	setItemsProcessed(state, state.range(0));
+}
+
+void pushBackIVector(benchmark::State& state) {
+	const size_t size = static_cast<size_t>(state.range(0));
+	if (!checkVector(state, createInt32Vector())) {
+		return;
+	}
+	for (auto _: state) {
+		auto pVector = createInt32Vector();
+		auto& rVector = *pVector;
+		for (size_t i=0; i<size; ++i) {
+			rVector.push_back(static_cast<int32_t>(i));
+		}
+		benchmark::DoNotOptimize(rVector.size());
+	}
+	setItemsProcessed(state, state.range(0));
+}
+
+// ---------------------------------------------------------------------------------------
+// Indexed read access with operator[]
+
+void indexNative(benchmark::State& state) {
+	const size_t size = static_cast<size_t>(state.range(0));
+	const vector<int32_t> v = makeSource(size);
+	for (auto _: state) {
+		int64_t sum = 0; // int32_t would overflow for the large sizes
+		for (size_t i=0; i<size; ++i) {
+			sum += v[i];
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	setItemsProcessed(state, state.range(0));
+}
+
+void indexIVector(benchmark::State& state) {
+	const size_t size = static_cast<size_t>(state.range(0));
+	auto pVector = createInt32Vector();
+	if (!checkVector(state, pVector)) {
+		return;
+	}
+	*pVector = makeSource(size);
+	const IVector<int32_t>& rVector = *pVector;
+	for (auto _: state) {
+		int64_t sum = 0;
+		for (size_t i=0; i<size; ++i) {
+			sum += rVector[i];
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	setItemsProcessed(state, state.range(0));
+}
+
+// ---------------------------------------------------------------------------------------
+// Iteration with a range based for loop
+
+void iterateNative(benchmark::State& state) {
+	const vector<int32_t> v = makeSource(static_cast<size_t>(state.range(0)));
+	for (auto _: state) {
+		int64_t sum = 0;
+		for (const auto x: v) {
+			sum += x;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	setItemsProcessed(state, state.range(0));
+}
+
+void iterateIVector(benchmark::State& state) {
+	auto pVector = createInt32Vector();
+	if (!checkVector(state, pVector)) {
+		return;
+	}
+	*pVector = makeSource(static_cast<size_t>(state.range(0)));
+	const IVector<int32_t>& rVector = *pVector;
+	for (auto _: state) {
+		int64_t sum = 0;
+		for (const auto x: rVector) {
+			sum += x;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	setItemsProcessed(state, state.range(0));
+}
+
+// ---------------------------------------------------------------------------------------
+// Assignment from a std::vector
+
+void assignFromStdVectorNative(benchmark::State& state) {
+	const vector<int32_t> src = makeSource(static_cast<size_t>(state.range(0)));
+	vector<int32_t> v;
+	for (auto _: state) {
+		v = src;
+		benchmark::DoNotOptimize(v.data());
+	}
+	setItemsProcessed(state, state.range(0));
+}
+
+void assignFromStdVectorIVector(benchmark::State& state) {
+	const vector<int32_t> src = makeSource(static_cast<size_t>(state.range(0)));
+	auto pVector = createInt32Vector();
+	if (!checkVector(state, pVector)) {
+		return;
+	}
+	auto& rVector = *pVector;
+	for (auto _: state) {
+		rVector = src;
+		benchmark::DoNotOptimize(rVector.size());
+	}
+	setItemsProcessed(state, state.range(0));
+}
+
+// ---------------------------------------------------------------------------------------
+// Conversion to a std::vector
+
+void convertToStdVectorNative(benchmark::State& state) {
+	const vector<int32_t> src = makeSource(static_cast<size_t>(state.range(0)));
+	for (auto _: state) {
+		const vector<int32_t> v = src;
+		benchmark::DoNotOptimize(v.data());
+	}
+	setItemsProcessed(state, state.range(0));
+}
+
+void convertToStdVectorIVector(benchmark::State& state) {
+	auto pVector = createInt32Vector();
+	if (!checkVector(state, pVector)) {
+		return;
+	}
+	*pVector = makeSource(static_cast<size_t>(state.range(0)));
+	const IVector<int32_t>& rVector = *pVector;
+	for (auto _: state) {
+		const vector<int32_t> v = rVector;
+		benchmark::DoNotOptimize(v.data());
+	}
+	setItemsProcessed(state, state.range(0));
+}
+
+// ---------------------------------------------------------------------------------------
+// Element access in nested vectors; range(0) is the number of inner vectors
+
+void nestedAccessNative(benchmark::State& state) {
+	const size_t size = static_cast<size_t>(state.range(0));
+	const vector<vector<int32_t>> v(size, makeSource(kInnerSize));
+	for (auto _: state) {
+		int64_t sum = 0;
+		for (size_t i=0; i<size; ++i) {
+			for (size_t j=0; j<kInnerSize; ++j) {
+				sum += v[i][j];
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	setItemsProcessed(state, state.range(0) * static_cast<int64_t>(kInnerSize));
+}
+
+void nestedAccessIVector(benchmark::State& state) {
+	const size_t size = static_cast<size_t>(state.range(0));
+	auto pVector = createInt32VectorVector();
+	if (!checkVector(state, pVector)) {
+		return;
+	}
+	*pVector = vector<vector<int32_t>>(size, makeSource(kInnerSize));
+	const IVector<IVector<int32_t>>& rVector = *pVector;
+	for (auto _: state) {
+		int64_t sum = 0;
+		for (size_t i=0; i<size; ++i) {
+			for (size_t j=0; j<kInnerSize; ++j) {
+				sum += rVector[i][j];
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	setItemsProcessed(state, state.range(0) * static_cast<int64_t>(kInnerSize));
+}
+
+void nestedExportFlatIVector(benchmark::State& state) {
+	const size_t size = static_cast<size_t>(state.range(0));
+	auto pVector = createInt32VectorVector();
+	if (!checkVector(state, pVector)) {
+		return;
+	}
+	*pVector = vector<vector<int32_t>>(size, makeSource(kInnerSize));
+	const IVector<IVector<int32_t>>& rVector = *pVector;
+	vector<abi_size_t> offsets;
+	vector<int32_t> values;
+	for (auto _: state) {
+		rVector.exportFlat(offsets, values);
+		int64_t sum = 0;
+		for (size_t i=0; i<size; ++i) {
+			for (abi_size_t j=offsets[i]; j<offsets[i + 1]; ++j) {
+				sum += values[j];
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	setItemsProcessed(state, state.range(0) * static_cast<int64_t>(kInnerSize));
+}
+
+}
+
+BENCHMARK(pushBackNative)->Apply(applySizes);
+BENCHMARK(pushBackIVector)->Apply(applySizes);
+BENCHMARK(indexNative)->Apply(applySizes);
+BENCHMARK(indexIVector)->Apply(applySizes);
+BENCHMARK(iterateNative)->Apply(applySizes);
+BENCHMARK(iterateIVector)->Apply(applySizes);
+BENCHMARK(assignFromStdVectorNative)->Apply(applySizes);
+BENCHMARK(assignFromStdVectorIVector)->Apply(applySizes);
+BENCHMARK(convertToStdVectorNative)->Apply(applySizes);
+BENCHMARK(convertToStdVectorIVector)->Apply(applySizes);
+BENCHMARK(nestedAccessNative)->Apply(applyNestedSizes);
+BENCHMARK(nestedAccessIVector)->Apply(applyNestedSizes);
+BENCHMARK(nestedExportFlatIVector)->Apply(applyNestedSizes);
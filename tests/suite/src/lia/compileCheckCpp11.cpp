@@ -0,0 +1,68 @@
+/*
++-----------------------------------+
+|                                   |
+|                 A                 |
+|                A A                |
+|               A   A               |
+|              A     A              |
+|  #  AAAAAAAAAAAAAAAAAAAAAAAAA  #  |
+|  ###       A         A       ###  |
+|  ######   A           A    #####  |
+|  ####### A             A #######  |
+|                                   |
++-----------------------------------+
+
+L I B A C R O S S - Using C++ containers
+ across DLL- and ABI-stable boundaries
+
+If you like this project, please refer to it with a link or
+some other reference. You can use this ASCII art icon as well
+as the supplied graphical icons for that purpose.
+
+(c) Copyright 2019 Jens Ganter-Benzing
+
+Licensed under the MIT license:
+
+http://www.opensource.org/licenses/mit-license.php
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+// Compiled as C++11 only, without being run: Checks that the headers and the value semantics of the implementations
+// stay usable with the oldest language version that has the C++11 API.
+#include <lia/IVector.h>
+#include <lia/BackInserter.h>
+#include <lia/BasicStringRef.h>
+#include <lia/ISharedPtr.h>
+#include <lia/Parallel.h>
+#include <string>
+#include <vector>
+
+std::size_t compileCheckCpp11();
+
+std::size_t compileCheckCpp11() {
+	std::vector<int> v;
+	auto ref = lia::detail::makeRef(v); // VectorRef must stay copyable for makeRef() to return it by value
+	lia::VectorRef<int, std::vector<int>&> copy(ref);
+	copy.push_back(1);
+	std::vector<int> other;
+	auto otherRef = lia::detail::makeRef(other);
+	lia::IVector<int>& rOther = otherRef;
+	rOther = std::move(static_cast<lia::IVector<int>&>(copy));
+	return ref.size() + otherRef.size();
+}
@@ -46,6 +46,7 @@ THE SOFTWARE.
 #include <gtest/gtest.h>
 #include <lia/DllLoader.h>
 #include <lia/IBasicString.h>
+#include <string>
 
 using namespace lia::dll_loader;
 
@@ -66,3 +67,16 @@ TEST(IBasicString, Blah) {
 		delete pString;
 	}
 }
+
+TEST(IBasicString, tryNative) {
+	const auto creators = getDllFunctions<CreateStringFunction>("createString");
+	EXPECT_GT(creators.size(), 0);
+	for (const auto creator: creators) {
+		auto* pString = (*creator)();
+		std::string* pNative = lia::tryNative<std::string>(*pString);
+		ASSERT_NE(pNative, nullptr); // the test library is built with the same toolchain as the test suite
+		EXPECT_TRUE(pNative->empty());
+		EXPECT_EQ(lia::tryNative<std::wstring>(*pString), nullptr);
+		pString->abiDestroy();
+	}
+}
@@ -43,11 +43,23 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <list>
 #include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <gtest/gtest.h>
 #include <lia/DllLoader.h>
 #include <lia/IVector.h>
+#include <lia/BackInserter.h>
+#include <lia/Parallel.h>
+#if lia_CPP20_API
+	#include <span>
+#endif
 
 using namespace lia::dll_loader;
 using namespace lia;
@@ -393,6 +405,40 @@ TEST(IVector, data) {
 	}
 }
 
+TEST(IVector, contiguousData) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		const auto& rcVectorSimple  = *pVectorSimple;
+		const auto& rcVectorComplex = *pVectorComplex;
+		{
+			const vector<int32_t> vs { 1, 2, 3 };
+			rVectorSimple = vs;
+			const int32_t* pData = nullptr;
+			abi_size_t size = 0;
+			abi_size_t capacity = 0;
+			ASSERT_TRUE(rcVectorSimple.abiGetDataConst(pData, &size, &capacity));
+			EXPECT_EQ(pData, rcVectorSimple.data());
+			EXPECT_EQ(size, 3);
+			EXPECT_GE(capacity, 3);
+			const vector<int32_t> copy = rcVectorSimple;
+			EXPECT_EQ(copy, vs);
+		}
+		{
+			const vector<vector<int32_t>> vc { { 1 }, { 1, 2 }, { 1, 2, 3 } };
+			rVectorComplex = vc;
+			const IVector<int32_t>* pData = nullptr;
+			EXPECT_FALSE(rcVectorComplex.abiGetDataConst(pData));
+			const vector<vector<int32_t>> copy = rcVectorComplex;
+			EXPECT_EQ(copy, vc);
+		}
+	}
+}
+
 TEST(IVector, iterateNonConst) {
 	const auto vecs = makeVectors();
 	EXPECT_GT(vecs.size(), 0);
@@ -477,8 +523,8 @@ TEST(IVector, iterateWithInterfaceUpcast) {
 			const vector<int32_t> vs { 1, 2, 3 };
 			rVectorSimple = vs;
 			int32_t j = 1;
-			auto iter = rVectorSimple.begin();
-			auto end = rVectorSimple.end();
+			VectorIteratorHandle<int32_t> iter = rVectorSimple.begin();
+			VectorIteratorHandle<int32_t> end = rVectorSimple.end();
 			IVectorIterator<int32_t>& rIter = iter;
 			IVectorIterator<int32_t>& rEnd = end;
 			for (;rIter != rEnd; ++rIter, ++j) {
@@ -491,6 +537,93 @@ TEST(IVector, iterateWithInterfaceUpcast) {
 	}
 }
 
+TEST(IVector, iterateMixedWithInterface) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		auto& rVectorSimple  = *pVectorSimple;
+		const auto& rcVectorSimple  = *pVectorSimple;
+		{
+			vector<int32_t> vs(1000);
+			iota(vs.begin(), vs.end(), 0);
+			rVectorSimple = vs;
+			EXPECT_EQ(accumulate(rcVectorSimple.begin(), rcVectorSimple.end(), int64_t(0)), 499500);
+			VectorIteratorHandle<int32_t> iter = rVectorSimple.begin() + 10;
+			auto copy = iter;
+			IVectorIterator<int32_t>& rCopy = copy; // iterator is accessed via its interface from now on
+			++rCopy;
+			EXPECT_EQ(*rCopy, 11);
+			EXPECT_EQ(*copy, 11);
+			EXPECT_EQ(copy - iter, 1);
+			EXPECT_EQ(iter + 1, copy);
+			EXPECT_EQ(copy, iter + 1);
+			const VectorIteratorHandle<int32_t> constHandle = rVectorSimple.begin() + 11;
+			EXPECT_EQ(constHandle - copy, 0); // compared through a materialized copy of constHandle
+			EXPECT_TRUE(copy == constHandle);
+			EXPECT_EQ(*constHandle, 11);
+			VectorIteratorHandle<const int32_t> constIter = copy;
+			EXPECT_EQ(*constIter, 11);
+			EXPECT_EQ(rcVectorSimple.end() - constIter, 989);
+			EXPECT_EQ(constIter - rcVectorSimple.begin(), 11);
+			EXPECT_EQ(rVectorSimple.end() - constIter, 989);
+			EXPECT_EQ(copy - rVectorSimple.begin(), 11);
+			EXPECT_TRUE(rVectorSimple.begin() + 11 == copy);
+			EXPECT_TRUE(copy == rcVectorSimple.begin() + 11);
+			EXPECT_TRUE(rVectorSimple.end() != constIter);
+			EXPECT_TRUE(rVectorSimple.begin() < copy);
+			EXPECT_TRUE(copy < rcVectorSimple.end());
+			EXPECT_TRUE(rcVectorSimple.end() > constIter);
+			EXPECT_TRUE(constIter > rVectorSimple.begin());
+			EXPECT_TRUE(rVectorSimple.begin() + 11 <= copy);
+			EXPECT_TRUE(copy <= rVectorSimple.begin() + 11);
+			EXPECT_TRUE(rcVectorSimple.begin() + 11 >= constIter);
+			EXPECT_TRUE(constIter >= rcVectorSimple.begin() + 11);
+			*iter = -1;
+			EXPECT_EQ(rcVectorSimple[10], -1);
+		}
+	}
+}
+
+TEST(IVector, indexIterator) {
+	static_assert(std::is_trivially_copyable<IVector<int32_t>::iterator>::value, "iterator must be trivially copyable");
+	static_assert(std::is_trivially_copyable<IVector<IVector<int32_t>>::const_iterator>::value, "iterator must be trivially copyable");
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		const auto& rcVectorComplex = *pVectorComplex;
+		{
+			rVectorSimple = vector<int32_t> { 5, 3, 4, 1, 2 };
+			sort(rVectorSimple.begin(), rVectorSimple.end());
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 1, 2, 3, 4, 5 }));
+			IVector<int32_t>::const_iterator iter = rVectorSimple.begin() + 2;
+			EXPECT_EQ(*iter, 3);
+			EXPECT_EQ(2 + rVectorSimple.cbegin(), iter);
+			EXPECT_TRUE(iter < rVectorSimple.cend());
+		}
+		{
+			const vector<vector<int32_t>> vc { { 1 }, { 1, 2 }, { 1, 2, 3 } };
+			rVectorComplex = vc;
+			const auto found = find_if(rcVectorComplex.begin(), rcVectorComplex.end(), [](lia_ELEM_CONST_REF(rcVectorComplex) element) { return element.size() == 2; });
+			EXPECT_EQ(found - rcVectorComplex.begin(), 1);
+			EXPECT_EQ(found[1].size(), 3);
+			// conversion into a handle for access over the iterator interface
+			VectorIteratorHandle<IVector<int32_t>> handle = rVectorComplex.begin() + 2;
+			IVectorIterator<IVector<int32_t>>& rIter = handle;
+			EXPECT_EQ(rIter->size(), 3);
+			VectorIteratorHandle<const IVector<int32_t>> constHandle = rVectorComplex.begin() + 1;
+			EXPECT_EQ(constHandle->size(), 2);
+			// inner vectors are accessed over proxies, which keep iterating over handles
+			auto inner = rVectorComplex[2];
+			EXPECT_EQ(accumulate(inner.begin(), inner.end(), 0), 6);
+		}
+	}
+}
+
 TEST(IVector, iterateRangeBased) {
 	const auto vecs = makeVectors();
 	EXPECT_GT(vecs.size(), 0);
@@ -567,6 +700,90 @@ TEST(IVector, iterateReverse) {
 	}
 }
 
+TEST(IVector, iterateReverseNative) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorComplex = *pVectorComplex;
+		const auto& rcVectorComplex = *pVectorComplex;
+		vector<vector<int32_t>> vc(5);
+		for (size_t j=0; j<vc.size(); ++j) {
+			vc[j].resize(j);
+		}
+		rVectorComplex = vc;
+		{
+			auto iter = rVectorComplex.rbegin();
+			EXPECT_EQ(iter->size(), 4);
+			EXPECT_EQ((iter++)->size(), 4);
+			EXPECT_EQ(iter->size(), 3);
+			EXPECT_EQ((iter + 2)->size(), 1);
+			EXPECT_EQ(iter[3].size(), 0);
+			EXPECT_EQ(rVectorComplex.rend() - iter, 4);
+			EXPECT_EQ(iter.base() - rVectorComplex.begin(), 4);
+			iter->push_back(42);
+			EXPECT_EQ(rVectorComplex[3].size(), 4);
+			iter += 4;
+			EXPECT_TRUE(iter == rVectorComplex.rend());
+			--iter;
+			EXPECT_TRUE(iter.base() == rVectorComplex.begin() + 1);
+		}
+		{
+			// natively reversed and wrapping reverse iterators are interchangeable
+			const IVector<IVector<int32_t>>::const_reverse_iterator wrapped(rcVectorComplex.end());
+			EXPECT_TRUE(wrapped == rcVectorComplex.rbegin());
+			EXPECT_TRUE((wrapped + 5) == rcVectorComplex.rend());
+			EXPECT_EQ(rcVectorComplex.rend() - wrapped, 5);
+			IVector<IVector<int32_t>>::const_reverse_iterator converted = rVectorComplex.rbegin();
+			EXPECT_TRUE(converted == rcVectorComplex.rcbegin());
+			size_t j = 5;
+			for (auto iter = rcVectorComplex.rcbegin(); iter != rcVectorComplex.rcend(); ++iter) {
+				--j;
+				EXPECT_EQ(iter->size(), (j == 3) ? 4 : j);
+			}
+			EXPECT_EQ(j, 0);
+		}
+	}
+}
+
+TEST(IVector, forEach) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		const auto& rcVectorSimple  = *pVectorSimple;
+		const auto& rcVectorComplex = *pVectorComplex;
+		{
+			rVectorSimple = vector<int32_t>(100, 1);
+			rVectorSimple.forEach([](int32_t& x) { x *= 2; });
+			int32_t sum = 0;
+			rcVectorSimple.forEach([&sum](const int32_t& x) { sum += x; });
+			EXPECT_EQ(sum, 200);
+		}
+		{
+			vector<vector<int32_t>> vc(100);
+			for (size_t j=0; j<vc.size(); ++j) {
+				vc[j].resize(j);
+			}
+			rVectorComplex = vc;
+			size_t j = 0;
+			rcVectorComplex.forEach([&j](lia_ELEM_CONST_REF(rcVectorComplex) element) {
+				EXPECT_EQ(element.size(), j);
+				++j;
+			});
+			EXPECT_EQ(j, 100);
+			rVectorComplex.forEach([](lia_ELEM_REF(rVectorComplex) element) { element.clear(); });
+			EXPECT_TRUE(rcVectorComplex[99].empty());
+			lia::detail::MakeTypes<IVector<int32_t>>::ConstPointer chunk[2];
+			EXPECT_TRUE(rcVectorComplex.abiGetRangeConst(98, 2, chunk));
+			EXPECT_FALSE(rcVectorComplex.abiGetRangeConst(99, 2, chunk));
+		}
+	}
+}
+
 TEST(IVector, empty) {
 	const auto vecs = makeVectors();
 	EXPECT_GT(vecs.size(), 0);
@@ -640,6 +857,29 @@ TEST(IVector, capacity) {
 	}
 }
 
+TEST(IVector, reserveAdditional) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		auto& rVectorSimple  = *pVectorSimple;
+		const auto& rcVectorSimple  = *pVectorSimple;
+		{
+			rVectorSimple = vector<int32_t>(100, 1);
+			EXPECT_EQ(rcVectorSimple.capacity(), 100);
+			rVectorSimple.reserveAdditional(1);
+			EXPECT_EQ(rcVectorSimple.capacity(), 200);
+			rVectorSimple.reserveAdditional(100);
+			EXPECT_EQ(rcVectorSimple.capacity(), 200);
+			rVectorSimple.reserveAdditional(150, kGrowthExact);
+			EXPECT_EQ(rcVectorSimple.capacity(), 250);
+			rVectorSimple.reserveAdditional(151, 150);
+			EXPECT_EQ(rcVectorSimple.capacity(), 375);
+			EXPECT_EQ(rcVectorSimple.size(), 100);
+		}
+	}
+}
+
 TEST(IVector, clear) {
 	const auto vecs = makeVectors();
 	EXPECT_GT(vecs.size(), 0);
@@ -728,6 +968,86 @@ TEST(IVector, insert) {
 	}
 }
 
+TEST(IVector, insertRange) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		const auto& rcVectorSimple  = *pVectorSimple;
+		const auto& rcVectorComplex = *pVectorComplex;
+		{ // more elements than fit into one chunk, inserted in the middle
+			vector<int32_t> x(1000);
+			for (size_t j=0; j<x.size(); ++j) {
+				x[j] = static_cast<int32_t>(j);
+			}
+			rVectorSimple = vector<int32_t> { -1, -2 };
+			auto iter = rVectorSimple.insert(rVectorSimple.begin() + 1, x.begin(), x.end());
+			EXPECT_EQ(iter, rVectorSimple.begin() + 1);
+			ASSERT_EQ(rcVectorSimple.size(), 1002);
+			EXPECT_EQ(rcVectorSimple[0], -1);
+			for (size_t j=0; j<x.size(); ++j) {
+				EXPECT_EQ(rcVectorSimple[j+1], x[j]);
+			}
+			EXPECT_EQ(rcVectorSimple[1001], -2);
+			rVectorSimple.clear();
+		}
+		{ // forward iterators without contiguous storage, inserted in the middle with one call
+			list<int32_t> x;
+			for (int32_t j=0; j<200; ++j) {
+				x.push_back(j);
+			}
+			rVectorSimple = vector<int32_t> { -1, -2, -3 };
+			rVectorSimple.insert(rVectorSimple.begin() + 2, x.begin(), x.end());
+			ASSERT_EQ(rcVectorSimple.size(), 203);
+			EXPECT_EQ(rcVectorSimple[1], -2);
+			EXPECT_EQ(rcVectorSimple[2], 0);
+			EXPECT_EQ(rcVectorSimple[201], 199);
+			EXPECT_EQ(rcVectorSimple[202], -3);
+			rVectorSimple.clear();
+		}
+		{
+			vector<vector<int32_t>> x(100);
+			for (size_t j=0; j<x.size(); ++j) {
+				x[j].resize(j);
+			}
+			rVectorComplex.assign(x.begin(), x.end());
+			rVectorComplex.insert(rVectorComplex.begin(), x.begin(), x.end());
+			ASSERT_EQ(rcVectorComplex.size(), 200);
+			for (size_t j=0; j<rcVectorComplex.size(); ++j) {
+				EXPECT_EQ(rcVectorComplex[j].size(), j % 100);
+			}
+			rVectorComplex.clear();
+		}
+	}
+}
+
+TEST(IVector, insertFill) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		auto& rVectorSimple  = *pVectorSimple;
+		const auto& rcVectorSimple  = *pVectorSimple;
+		{
+			rVectorSimple = vector<int32_t> { 1, 2, 3 };
+			auto iter = rVectorSimple.insert(rVectorSimple.begin() + 1, std::size_t(1000), 7);
+			EXPECT_EQ(iter, rVectorSimple.begin() + 1);
+			ASSERT_EQ(rcVectorSimple.size(), 1003);
+			EXPECT_EQ(rcVectorSimple[0], 1);
+			for (size_t j=1; j<1001; ++j) {
+				EXPECT_EQ(rcVectorSimple[j], 7);
+			}
+			EXPECT_EQ(rcVectorSimple[1001], 2);
+			EXPECT_EQ(rcVectorSimple[1002], 3);
+			rVectorSimple.assign(std::size_t(5), int32_t(8));
+			EXPECT_EQ(static_cast<vector<int32_t>>(rcVectorSimple), vector<int32_t>(5, 8));
+		}
+	}
+}
+
 TEST(IVector, emplace) {
 	const auto vecs = makeVectors();
 	EXPECT_GT(vecs.size(), 0);
@@ -764,6 +1084,234 @@ TEST(IVector, erase) {
 	}
 }
 
+// Counts its copies, moving it is free
+struct CopyCounter {
+	CopyCounter(): value(0), pCopies(nullptr) {}
+	CopyCounter(int v, int* p): value(v), pCopies(p) {}
+	CopyCounter(const CopyCounter& other): value(other.value), pCopies(other.pCopies) { count(); }
+	CopyCounter(CopyCounter&& other) noexcept: value(other.value), pCopies(other.pCopies) {}
+	CopyCounter& operator=(const CopyCounter& other) { value = other.value; pCopies = other.pCopies; count(); return *this; }
+	CopyCounter& operator=(CopyCounter&& other) noexcept { value = other.value; pCopies = other.pCopies; return *this; }
+
+	void count() { if (pCopies != nullptr) { ++*pCopies; } }
+
+	int  value;
+	int* pCopies;
+};
+
+TEST(IVector, backInserter) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		auto& rVectorSimple  = *pVectorSimple;
+		const auto& rcVectorSimple  = *pVectorSimple;
+		{
+			rVectorSimple = vector<int32_t> { -1 };
+			{
+				BackInserter<int32_t, 16> inserter(rVectorSimple);
+				for (int32_t j=0; j<1000; ++j) {
+					inserter.push_back(j);
+				}
+				EXPECT_EQ(inserter.staged(), 8);
+				EXPECT_EQ(rcVectorSimple.size(), 993);
+				inserter.flush();
+				EXPECT_EQ(inserter.staged(), 0);
+				EXPECT_EQ(rcVectorSimple.size(), 1001);
+				inserter.push_back(1000);
+				EXPECT_EQ(rcVectorSimple.size(), 1001);
+			}
+			ASSERT_EQ(rcVectorSimple.size(), 1002);
+			EXPECT_EQ(rcVectorSimple[0], -1);
+			for (int32_t j=0; j<=1000; ++j) {
+				EXPECT_EQ(rcVectorSimple[j+1], j);
+			}
+		}
+	}
+	{
+		// Elements that are expensive to copy are moved into the vector
+		vector<CopyCounter> native;
+		VectorRef<CopyCounter, vector<CopyCounter>&> ref(native);
+		int copies = 0;
+		{
+			BackInserter<CopyCounter, 4> inserter(ref);
+			CopyCounter value(0, &copies);
+			inserter.push_back(value);
+			inserter.push_back(CopyCounter(1, &copies));
+			for (int j=2; j<10; ++j) {
+				inserter.emplace_back(j, &copies);
+			}
+			EXPECT_EQ(inserter.staged(), 2);
+		}
+		ASSERT_EQ(native.size(), 10);
+		for (int j=0; j<10; ++j) {
+			EXPECT_EQ(native[j].value, j);
+		}
+		EXPECT_EQ(copies, 1); // only the lvalue was copied into the buffer
+	}
+	{
+		vector<std::string> native;
+		VectorRef<std::string, vector<std::string>&> ref(native);
+		{
+			BackInserter<std::string, 2> inserter(ref);
+			inserter.emplace_back(3u, 'a');
+			inserter.push_back(std::string(40, 'b'));
+			inserter.push_back("c");
+		}
+		EXPECT_EQ(native, (vector<std::string> { "aaa", std::string(40, 'b'), "c" }));
+	}
+}
+
+TEST(IVector, resize) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		const auto& rcVectorSimple  = *pVectorSimple;
+		const auto& rcVectorComplex = *pVectorComplex;
+		{
+			rVectorSimple = vector<int32_t> { 1, 2, 3 };
+			rVectorSimple.resize(5);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rcVectorSimple), (vector<int32_t> { 1, 2, 3, 0, 0 }));
+			rVectorSimple.resize(7, 9);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rcVectorSimple), (vector<int32_t> { 1, 2, 3, 0, 0, 9, 9 }));
+			rVectorSimple.resize(2);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rcVectorSimple), (vector<int32_t> { 1, 2 }));
+		}
+		{
+			rVectorComplex = vector<vector<int32_t>> { { 1 } };
+			rVectorComplex.resize(3);
+			ASSERT_EQ(rcVectorComplex.size(), 3);
+			EXPECT_EQ(rcVectorComplex[0].size(), 1);
+			EXPECT_TRUE(rcVectorComplex[2].empty());
+			rVectorComplex.resize(0);
+			EXPECT_TRUE(rcVectorComplex.empty());
+		}
+	}
+}
+
+TEST(IVector, popBack) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		auto& rVectorSimple  = *pVectorSimple;
+		const auto& rcVectorSimple  = *pVectorSimple;
+		{
+			rVectorSimple = vector<int32_t> { 1, 2 };
+			rVectorSimple.pop_back();
+			ASSERT_EQ(rcVectorSimple.size(), 1);
+			EXPECT_EQ(rcVectorSimple[0], 1);
+			rVectorSimple.pop_back();
+			EXPECT_TRUE(rcVectorSimple.empty());
+			rVectorSimple.pop_back();
+			EXPECT_TRUE(rcVectorSimple.empty());
+		}
+	}
+}
+
+TEST(IVector, emplaceBack) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		auto& rVectorSimple  = *pVectorSimple;
+		const auto& rcVectorSimple  = *pVectorSimple;
+		{
+			int32_t& rElem = rVectorSimple.emplace_back(5);
+			EXPECT_EQ(rElem, 5);
+			ASSERT_EQ(rcVectorSimple.size(), 1);
+			EXPECT_EQ(rcVectorSimple[0], 5);
+		}
+	}
+}
+
+// Container type of its own, so that vectors using it can't exchange their storage with other vectors
+template<typename T>
+struct OtherAllocator: std::allocator<T> {
+	template<typename U>
+	struct rebind {
+		typedef OtherAllocator<U> other;
+	};
+	OtherAllocator() {}
+	template<typename U>
+	OtherAllocator(const OtherAllocator<U>&) {}
+};
+
+TEST(IVector, swap) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<int32_t>> pOtherSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		unique_ptr<IVector<IVector<int32_t>>> pOtherComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rOtherSimple   = *pOtherSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		auto& rOtherComplex  = *pOtherComplex;
+		{ // same implementation: the storage is exchanged
+			rVectorSimple = vector<int32_t> { 1, 2, 3 };
+			rOtherSimple  = vector<int32_t> { 4, 5 };
+			const int32_t* pData  = rVectorSimple.data();
+			const int32_t* pOther = rOtherSimple.data();
+			rVectorSimple.swap(rOtherSimple);
+			EXPECT_EQ(rVectorSimple.data(), pOther);
+			EXPECT_EQ(rOtherSimple.data(), pData);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 4, 5 }));
+			EXPECT_EQ(static_cast<vector<int32_t>>(rOtherSimple), (vector<int32_t> { 1, 2, 3 }));
+		}
+		{ // other module: the storage is exchanged for the same toolchain and container type, the elements are copied otherwise
+			vector<int32_t> v { 6, 7, 8, 9 };
+			auto ref = lia::detail::makeRef(v);
+			rVectorSimple.swap(ref);
+			EXPECT_EQ(v, (vector<int32_t> { 4, 5 }));
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 6, 7, 8, 9 }));
+		}
+		{ // different container type: the elements are copied
+			vector<int32_t, OtherAllocator<int32_t>> v { 10, 11 };
+			VectorRef<int32_t, vector<int32_t, OtherAllocator<int32_t>>&> ref(v);
+			rVectorSimple.swap(ref);
+			EXPECT_EQ(v, (vector<int32_t, OtherAllocator<int32_t>> { 6, 7, 8, 9 }));
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 10, 11 }));
+			ref.swap(rVectorSimple);
+			EXPECT_EQ(v, (vector<int32_t, OtherAllocator<int32_t>> { 10, 11 }));
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 6, 7, 8, 9 }));
+		}
+		{
+			rVectorComplex = vector<vector<int32_t>> { { 1 }, { 1, 2 } };
+			rOtherComplex  = vector<vector<int32_t>> { { 1, 2, 3 } };
+			swap(rVectorComplex, rOtherComplex);
+			ASSERT_EQ(rVectorComplex.size(), 1);
+			EXPECT_EQ(rVectorComplex[0].size(), 3);
+			ASSERT_EQ(rOtherComplex.size(), 2);
+			EXPECT_EQ(rOtherComplex[1].size(), 2);
+		}
+	}
+}
+
+TEST(IVector, moveAssignment) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<int32_t>> pOtherSimple((*vecs[i].first)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rOtherSimple   = *pOtherSimple;
+		{
+			rOtherSimple = vector<int32_t> { 1, 2, 3 };
+			const int32_t* pData = rOtherSimple.data();
+			rVectorSimple = std::move(rOtherSimple);
+			EXPECT_EQ(rVectorSimple.data(), pData);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 1, 2, 3 }));
+			EXPECT_TRUE(rOtherSimple.empty());
+		}
+	}
+}
+
 TEST(IVector, conversionOfIteratorIntoConstIterator) {
 	const auto vecs = makeVectors();
 	EXPECT_GT(vecs.size(), 0);
@@ -778,3 +1326,757 @@ TEST(IVector, conversionOfIteratorIntoConstIterator) {
 		}
 	}
 }
+
+TEST(IVector, visitChunks) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		const auto& rcVectorSimple  = *pVectorSimple;
+		const auto& rcVectorComplex = *pVectorComplex;
+		{
+			vector<int32_t> v(1000);
+			iota(v.begin(), v.end(), 0);
+			rVectorSimple = v;
+			EXPECT_TRUE(rVectorSimple.visitChunks([](int32_t* pElems, size_t n) {
+				for (size_t j=0; j<n; ++j) {
+					pElems[j] *= 2;
+				}
+				return true;
+			}));
+			int64_t sum = 0;
+			EXPECT_TRUE(rcVectorSimple.visitChunks([&sum](const int32_t* pElems, size_t n) {
+				sum = accumulate(pElems, pElems + n, sum);
+				return true;
+			}));
+			EXPECT_EQ(sum, 999 * 1000);
+			size_t visited = 0;
+			EXPECT_TRUE(rcVectorSimple.visitChunks(10, 20, [&visited](const int32_t* pElems, size_t n) {
+				EXPECT_EQ(pElems[0], static_cast<int32_t>(2 * (10 + visited)));
+				visited += n;
+				return true;
+			}));
+			EXPECT_EQ(visited, 20);
+			EXPECT_FALSE(rcVectorSimple.visitChunks([](const int32_t*, size_t) { return false; }));
+			EXPECT_THROW(rcVectorSimple.visitChunks(1001, 1, [](const int32_t*, size_t) { return true; }), std::out_of_range);
+			EXPECT_THROW(rcVectorSimple.visitChunks([](const int32_t*, size_t) -> bool { throw std::runtime_error("test"); }), std::runtime_error);
+		}
+		{
+			vector<vector<int32_t>> vc(200);
+			for (size_t j=0; j<vc.size(); ++j) {
+				vc[j].resize(j);
+			}
+			rVectorComplex = vc;
+			size_t j = 0;
+			size_t chunks = 0;
+			EXPECT_TRUE(rcVectorComplex.visitChunks([&](lia::detail::MakeTypes<IVector<int32_t>>::ConstPointer* pElems, size_t n) {
+				for (size_t k=0; k<n; ++k, ++j) {
+					EXPECT_EQ(pElems[k]->size(), j);
+				}
+				++chunks;
+				return true;
+			}));
+			EXPECT_EQ(j, 200);
+			EXPECT_LT(chunks, 200);
+			EXPECT_TRUE(rVectorComplex.visitChunks([](lia::detail::MakeTypes<IVector<int32_t>>::Pointer* pElems, size_t n) {
+				for (size_t k=0; k<n; ++k) {
+					pElems[k]->clear();
+				}
+				return true;
+			}));
+			EXPECT_TRUE(rcVectorComplex[199].empty());
+		}
+	}
+}
+
+TEST(IVector, flatExportImport) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorComplex = *pVectorComplex;
+		const auto& rcVectorComplex = *pVectorComplex;
+		{
+			rVectorComplex = vector<vector<int32_t>> { { 1 }, {}, { 2, 3 }, { 4, 5, 6 } };
+			EXPECT_EQ(rcVectorComplex.flatSize(), 6);
+			vector<abi_size_t> offsets;
+			vector<int32_t> values;
+			rcVectorComplex.exportFlat(offsets, values);
+			EXPECT_EQ(offsets, (vector<abi_size_t> { 0, 1, 1, 3, 6 }));
+			EXPECT_EQ(values, (vector<int32_t> { 1, 2, 3, 4, 5, 6 }));
+			EXPECT_THROW(rcVectorComplex.exportFlat(&offsets[0], &values[0], 5), std::length_error);
+		}
+		{
+			const abi_size_t offsets[] = { 0, 2, 2, 5 };
+			const int32_t values[] = { 7, 8, 9, 10, 11 };
+			rVectorComplex.importFlat(offsets, 3, values);
+			EXPECT_EQ(static_cast<vector<vector<int32_t>>>(rcVectorComplex), (vector<vector<int32_t>> { { 7, 8 }, {}, { 9, 10, 11 } }));
+			const abi_size_t invalidOffsets[] = { 0, 2, 1 };
+			EXPECT_THROW(rVectorComplex.importFlat(invalidOffsets, 2, values), std::invalid_argument);
+			EXPECT_EQ(rcVectorComplex.size(), 3);
+			rVectorComplex.importFlat(offsets, 0, values);
+			EXPECT_TRUE(rcVectorComplex.empty());
+		}
+	}
+}
+
+// An iterator over an array, which reports flags in all bytes of its capabilities. Only the non-const iterator can be cloned.
+const uint32_t kWideCaps = 0x80010180u;
+
+class WideCapsIterator: public IVectorIterator<int32_t> {
+public:
+	explicit WideCapsIterator(int32_t* p): m_p(p) {}
+
+	void lia_CALL abiGetIVectorIteratorVersion(InterfaceVersion& v) const noexcept override { v.major = 0; v.minor = 3; }
+	void lia_CALL abiCloneTo(void* pBuf, abi_bool_t) const noexcept override { new(pBuf) WideCapsIterator(m_p); }
+	void lia_CALL abiMoveTo(void* pBuf) noexcept override { new(pBuf) WideCapsIterator(m_p); }
+	void lia_CALL abiFinalize() noexcept override {}
+	abi_ptrdiff_t lia_CALL abiGetDistance(const IVectorIterator<int32_t>& other) const noexcept override { return m_p - static_cast<const WideCapsIterator&>(other).m_p; }
+	void lia_CALL abiAdvance(abi_ptrdiff_t n) noexcept override { m_p += n; }
+	void lia_CALL abiDereference(int32_t*& pElem, abi_ptrdiff_t i) const noexcept override { pElem = m_p + i; }
+	void lia_CALL abiConstructBase(void* pBuf, abi_bool_t) const noexcept override { new(pBuf) WideCapsIterator(m_p); }
+	uint32_t lia_CALL abiGetCapabilities(const char*) const noexcept override { return kWideCaps; }
+
+private:
+	int32_t* m_p;
+};
+
+TEST(IVector, capabilities) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		{
+			const uint32_t caps = rVectorSimple.capabilities();
+			EXPECT_EQ(caps & (kCapContiguousStorage | kCapTriviallyRelocatable | kCapBulkInsert | kCapNativeAlgorithms), kCapContiguousStorage | kCapTriviallyRelocatable | kCapBulkInsert | kCapNativeAlgorithms);
+			const uint32_t nestedCaps = rVectorComplex.capabilities();
+			EXPECT_EQ(nestedCaps & (kCapContiguousStorage | kCapTriviallyRelocatable), 0u);
+			EXPECT_EQ(nestedCaps & kCapBulkInsert, kCapBulkInsert);
+		}
+		{ // assignments take the memcpy path for contiguous, trivially relocatable elements
+			rVectorSimple = vector<int32_t> { 1, 2, 3 };
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 1, 2, 3 }));
+			unique_ptr<IVector<int32_t>> pOther((*vecs[i].first)());
+			*pOther = vector<int32_t> { 4, 5 };
+			rVectorSimple = *pOther;
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 4, 5 }));
+		}
+		{ // the capabilities of iterators are queried once and kept by copies of the handle
+			const VectorIteratorHandle<int32_t> iter = rVectorSimple.begin();
+			EXPECT_EQ(iter.capabilities() & kCapContiguousStorage, kCapContiguousStorage);
+			const VectorIteratorHandle<int32_t> copy = iter;
+			EXPECT_EQ(copy.capabilities(), iter.capabilities());
+			VectorIteratorHandle<int32_t> reverseIter;
+			rVectorSimple.abiConstructReverseIterator(abi_true, reverseIter.getBuffer());
+			reverseIter.setConstructed();
+			EXPECT_EQ(reverseIter.capabilities() & kCapContiguousStorage, 0u);
+			const VectorIteratorHandle<IVector<int32_t>> nestedIter = rVectorComplex.begin();
+			EXPECT_EQ(nestedIter.capabilities() & kCapContiguousStorage, 0u);
+		}
+		{ // all 32 bits of the flags are kept
+			int32_t values[2] = { 1, 2 };
+			VectorIteratorHandle<int32_t> iter;
+			new(iter.getBuffer()) WideCapsIterator(values);
+			iter.setConstructed();
+			EXPECT_EQ(iter.capabilities(), kWideCaps);
+			const VectorIteratorHandle<int32_t> copy = iter;
+			EXPECT_EQ(copy.capabilities(), kWideCaps);
+			EXPECT_EQ(*(copy + 1), 2);
+		}
+	}
+}
+
+TEST(IVector, tryNative) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		const auto& rcVectorSimple = *pVectorSimple;
+		{ // the test library is built with the same toolchain as the test suite
+			rVectorSimple = vector<int32_t> { 1, 2, 3 };
+			vector<int32_t>* pNative = tryNative<vector<int32_t>>(rVectorSimple);
+			ASSERT_NE(pNative, nullptr);
+			EXPECT_EQ(*pNative, (vector<int32_t> { 1, 2, 3 }));
+			pNative->push_back(4);
+			EXPECT_EQ(rcVectorSimple.size(), 4);
+			EXPECT_EQ(rcVectorSimple[3], 4);
+			EXPECT_EQ(tryNative<vector<int32_t>>(rcVectorSimple), pNative);
+		}
+		{
+			EXPECT_EQ(tryNative<vector<int32_t>>(rVectorComplex), nullptr);
+			rVectorComplex = vector<vector<int32_t>> { { 1 }, { 2, 3 } };
+			vector<vector<int32_t>>* pNative = tryNative<vector<vector<int32_t>>>(rVectorComplex);
+			ASSERT_NE(pNative, nullptr);
+			EXPECT_EQ((*pNative)[1], (vector<int32_t> { 2, 3 }));
+		}
+	}
+}
+
+TEST(IVector, moveInsert) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		{
+			int32_t value = 2;
+			rVectorSimple.push_back(std::move(value));
+			rVectorSimple.insert(rVectorSimple.begin(), 1);
+			rVectorSimple.emplace(rVectorSimple.end(), 3);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 1, 2, 3 }));
+		}
+		{ // the test library is built with the same toolchain, so inner vectors are moved into it
+			vector<int32_t> inner { 1, 2, 3 };
+			const int32_t* pInnerData = inner.data();
+			rVectorComplex.push_back(std::move(inner));
+			ASSERT_EQ(rVectorComplex.size(), 1);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorComplex[0]), (vector<int32_t> { 1, 2, 3 }));
+			EXPECT_EQ(&rVectorComplex[0][0], pInnerData);
+			EXPECT_TRUE(inner.empty());
+			auto back = rVectorComplex.emplace_back();
+			EXPECT_TRUE(back.empty());
+			back.push_back(4);
+			EXPECT_EQ(static_cast<vector<vector<int32_t>>>(rVectorComplex), (vector<vector<int32_t>> { { 1, 2, 3 }, { 4 } }));
+		}
+	}
+}
+
+#if lia_CPP20_API
+static_assert(std::ranges::contiguous_range<VectorView<int32_t>>);
+static_assert(std::ranges::contiguous_range<VectorView<const int32_t>>);
+static_assert(std::ranges::random_access_range<VectorView<IVector<int32_t>>>);
+static_assert(std::ranges::view<VectorView<int32_t>>);
+static_assert(std::ranges::borrowed_range<VectorView<int32_t>>);
+#endif
+
+TEST(IVector, view) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		const auto& rcVectorSimple = *pVectorSimple;
+		{
+			EXPECT_TRUE(rcVectorSimple.view().empty());
+			rVectorSimple = vector<int32_t> { 3, 1, 2 };
+			const VectorView<int32_t> view = rVectorSimple.view();
+			ASSERT_EQ(view.size(), 3);
+			EXPECT_EQ(view.begin(), &rVectorSimple[0]);
+			std::sort(view.begin(), view.end());
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 1, 2, 3 }));
+			const VectorView<const int32_t> constView = rcVectorSimple.view();
+			EXPECT_EQ(std::accumulate(constView.begin(), constView.end(), 0), 6);
+			EXPECT_EQ(constView.front(), 1);
+			EXPECT_EQ(constView.back(), 3);
+#if lia_CPP20_API
+			const std::span<const int32_t> span(constView);
+			EXPECT_EQ(span.size(), 3);
+			EXPECT_EQ(std::ranges::count_if(constView, [](int32_t x) { return x > 1; }), 2);
+#endif
+		}
+		{
+			rVectorComplex = vector<vector<int32_t>> { { 1 }, { 2, 3 } };
+			const auto view = rVectorComplex.view();
+			ASSERT_EQ(view.size(), 2);
+			EXPECT_EQ(view[1].size(), 2);
+			size_t numElements = 0;
+			for (const auto inner: view) {
+				numElements += inner.size();
+			}
+			EXPECT_EQ(numElements, 3);
+		}
+	}
+}
+
+TEST(IVector, compareAndHash) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<int32_t>> pOtherSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		unique_ptr<IVector<IVector<int32_t>>> pOtherComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rOtherSimple   = *pOtherSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		auto& rOtherComplex  = *pOtherComplex;
+		{
+			vector<int32_t> native { 1, 2, 3 };
+			VectorRef<int32_t, vector<int32_t>&> nativeRef(native);
+			rVectorSimple = native;
+			rOtherSimple = native;
+			EXPECT_TRUE(rVectorSimple == rOtherSimple);
+			EXPECT_TRUE(rVectorSimple == nativeRef);
+			EXPECT_FALSE(rVectorSimple != rOtherSimple);
+			EXPECT_EQ(rVectorSimple.hashValue(), rOtherSimple.hashValue());
+			EXPECT_EQ(std::hash<IVector<int32_t>>()(rVectorSimple), nativeRef.hashValue());
+			rOtherSimple.push_back(0);
+			EXPECT_TRUE(rVectorSimple != rOtherSimple);
+			EXPECT_TRUE(rVectorSimple < rOtherSimple);
+			EXPECT_TRUE(rVectorSimple <= rOtherSimple);
+			EXPECT_NE(rVectorSimple.hashValue(), rOtherSimple.hashValue());
+			rOtherSimple = vector<int32_t> { 1, 3 };
+			EXPECT_TRUE(rOtherSimple > rVectorSimple);
+			EXPECT_TRUE(rOtherSimple >= rVectorSimple);
+			EXPECT_FALSE(rOtherSimple < rVectorSimple);
+		}
+		{
+			rVectorComplex = vector<vector<int32_t>> { { 1 }, { 2, 3 } };
+			rOtherComplex = vector<vector<int32_t>> { { 1 }, { 2, 3 } };
+			EXPECT_TRUE(rVectorComplex == rOtherComplex);
+			EXPECT_TRUE(rVectorComplex[1] == rOtherComplex[1]);
+			EXPECT_TRUE(rVectorComplex[0] != rOtherComplex[1]);
+			EXPECT_TRUE(rVectorComplex[0] < rOtherComplex[1]);
+			EXPECT_EQ(rVectorComplex.hashValue(), rOtherComplex.hashValue());
+			rOtherComplex[1].push_back(4);
+			EXPECT_FALSE(rVectorComplex == rOtherComplex);
+			EXPECT_TRUE(rVectorComplex < rOtherComplex);
+			EXPECT_NE(rVectorComplex.hashValue(), rOtherComplex.hashValue());
+		}
+	}
+}
+
+TEST(IVector, sort) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		{
+			rVectorSimple = vector<int32_t> { 5, 3, 4, 1, 2 };
+			rVectorSimple.sort();
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 1, 2, 3, 4, 5 }));
+			rVectorSimple.sort([](int32_t a, int32_t b) { return a > b; });
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 5, 4, 3, 2, 1 }));
+			rVectorSimple = vector<int32_t> { 31, 12, 21, 11, 32 };
+			rVectorSimple.stableSort([](int32_t a, int32_t b) { return (a % 10) < (b % 10); });
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 31, 21, 11, 12, 32 }));
+		}
+		{
+			rVectorSimple = vector<int32_t> { 5, 3, 4, 1, 2 };
+			rVectorSimple.partialSort(2);
+			EXPECT_EQ(rVectorSimple[0], 1);
+			EXPECT_EQ(rVectorSimple[1], 2);
+			rVectorSimple = vector<int32_t> { 5, 3, 4, 1, 2 };
+			rVectorSimple.nthElement(2);
+			EXPECT_EQ(rVectorSimple[2], 3);
+			EXPECT_LT(std::max(rVectorSimple[0], rVectorSimple[1]), 3);
+			EXPECT_THROW(rVectorSimple.nthElement(6), std::out_of_range);
+		}
+		{
+			vector<int32_t> native(100000);
+			for (size_t j=0; j<native.size(); ++j) {
+				native[j] = static_cast<int32_t>((j * 7919u) % 100003u);
+			}
+			rVectorSimple = native;
+			rVectorSimple.parallelSort(4);
+			std::sort(native.begin(), native.end());
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), native);
+		}
+		{
+			rVectorComplex = vector<vector<int32_t>> { { 3 }, { 1, 2 }, { 1 } };
+			rVectorComplex.sort();
+			EXPECT_EQ(static_cast<vector<vector<int32_t>>>(rVectorComplex), (vector<vector<int32_t>> { { 1 }, { 1, 2 }, { 3 } }));
+			rVectorComplex.stableSort([](const auto& a, const auto& b) { return a.size() > b.size(); });
+			EXPECT_EQ(static_cast<vector<vector<int32_t>>>(rVectorComplex), (vector<vector<int32_t>> { { 1, 2 }, { 1 }, { 3 } }));
+			rVectorComplex.nthElement(0);
+			EXPECT_EQ(rVectorComplex[0][0], 1);
+			EXPECT_EQ(rVectorComplex[0].size(), 1);
+			EXPECT_THROW(rVectorComplex.sort([](const auto&, const auto&) -> bool { throw std::runtime_error("in comparator"); }), std::runtime_error);
+			EXPECT_EQ(rVectorComplex.size(), 3);
+		}
+	}
+}
+
+namespace {
+
+// Has neither operator< nor operator==
+struct NotComparable {
+	int32_t value;
+};
+
+}
+
+TEST(IVector, elementsWithoutOperators) {
+	vector<NotComparable> values { { 3 }, { 1 }, { 2 } };
+	VectorRef<NotComparable, vector<NotComparable>&> ref(values);
+	IVector<NotComparable>& rVector = ref;
+	EXPECT_FALSE(rVector.abiSort(kSortUnstable, 0, nullptr, nullptr, 1u));
+	const NotComparable value { 1 };
+	const NotComparable* pValue = &value;
+	abi_size_t result[2] = { 0, 0 };
+	EXPECT_FALSE(rVector.abiFind(kSearchFind, 0, 3, pValue, nullptr, nullptr, result));
+	EXPECT_FALSE(rVector.abiBinarySearch(kSearchLowerBound, 0, 3, pValue, nullptr, nullptr, result));
+	EXPECT_FALSE(rVector.abiUnique(0, 3, nullptr, nullptr, nullptr));
+	rVector.sort([](const NotComparable& a, const NotComparable& b) { return a.value < b.value; });
+	EXPECT_EQ(values[0].value, 1);
+	EXPECT_EQ(rVector.findIndexIf([](const NotComparable& x) { return x.value == 3; }), 2u);
+	vector<vector<NotComparable>> nested { { { 1 } }, { } };
+	VectorRef<IVector<NotComparable>, vector<vector<NotComparable>>&> nestedRef(nested);
+	EXPECT_FALSE(static_cast<IVector<IVector<NotComparable>>&>(nestedRef).abiSort(kSortUnstable, 0, nullptr, nullptr, 1u));
+}
+
+TEST(IVector, search) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		{
+			vector<int32_t> native(1000);
+			for (size_t j=0; j<native.size(); ++j) {
+				native[j] = static_cast<int32_t>(j / 2u);
+			}
+			rVectorSimple = native;
+			EXPECT_EQ(rVectorSimple.findIndex(300), 600);
+			EXPECT_EQ(rVectorSimple.findIndex(300, 601), 601);
+			EXPECT_EQ(rVectorSimple.findIndex(300, 602), 1000);
+			EXPECT_EQ(rVectorSimple.findIndex(-1), 1000);
+			EXPECT_EQ(rVectorSimple.findIndexIf([](int32_t x) { return x > 400; }), 802);
+			EXPECT_EQ(rVectorSimple.count(7), 2);
+			EXPECT_EQ(rVectorSimple.countIf([](int32_t x) { return (x % 100) == 0; }), 10);
+			EXPECT_EQ(rVectorSimple.lowerBound(300), 600);
+			EXPECT_EQ(rVectorSimple.upperBound(300), 602);
+			EXPECT_EQ(rVectorSimple.equalRange(300), std::make_pair(size_t(600), size_t(602)));
+			EXPECT_EQ(rVectorSimple.equalRange(1000), std::make_pair(size_t(1000), size_t(1000)));
+			rVectorSimple.sort([](int32_t a, int32_t b) { return a > b; });
+			EXPECT_EQ(rVectorSimple.lowerBound(300, [](int32_t a, int32_t b) { return a > b; }), 398);
+		}
+		{
+			rVectorComplex = vector<vector<int32_t>> { { 1 }, { 1, 2 }, { 1, 2 }, { 3 } };
+			EXPECT_EQ(rVectorComplex.findIndex(vector<int32_t> { 1, 2 }), 1);
+			EXPECT_EQ(rVectorComplex.findIndex(vector<int32_t> { 1, 2 }, 2), 2);
+			EXPECT_EQ(rVectorComplex.findIndex(vector<int32_t> { 2 }), 4);
+			EXPECT_EQ(rVectorComplex.count(vector<int32_t> { 1, 2 }), 2);
+			EXPECT_EQ(rVectorComplex.findIndexIf([](const auto& inner) { return inner[0] == 3; }), 3);
+			EXPECT_EQ(rVectorComplex.countIf([](const auto& inner) { return inner.size() == 1; }), 2);
+			EXPECT_EQ(rVectorComplex.equalRange(vector<int32_t> { 1, 2 }), std::make_pair(size_t(1), size_t(3)));
+			EXPECT_EQ(rVectorComplex.upperBound(vector<int32_t> { 1, 5 }, [](const auto& a, const auto& b) { return a[0] < b[0]; }), 3);
+			EXPECT_THROW(rVectorComplex.findIndexIf([](const auto&) -> bool { throw std::runtime_error("in predicate"); }), std::runtime_error);
+		}
+	}
+}
+
+TEST(IVector, reduce) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<int32_t>> pOtherSimple((*vecs[i].first)());
+		auto& rVectorSimple = *pVectorSimple;
+		auto& rOtherSimple  = *pOtherSimple;
+		{
+			EXPECT_EQ(rVectorSimple.sum(), 0);
+			EXPECT_EQ(rVectorSimple.argMin(), 0);
+			EXPECT_THROW(rVectorSimple.minValue(), std::out_of_range);
+			vector<int32_t> native(1003);
+			vector<int32_t> other(native.size());
+			for (size_t j=0; j<native.size(); ++j) {
+				native[j] = static_cast<int32_t>((j * 7919u) % 1009u) - 500 + ((j == 700u) ? 2000000000 : 0);
+				other[j] = static_cast<int32_t>(j % 7u) - 3;
+			}
+			rVectorSimple = native;
+			rOtherSimple = other;
+			int64_t sum = 0;
+			int64_t dot = 0;
+			for (size_t j=0; j<native.size(); ++j) {
+				sum += native[j];
+				dot += int64_t(native[j]) * other[j];
+			}
+			EXPECT_EQ(rVectorSimple.sum(), sum);
+			EXPECT_EQ(rVectorSimple.dot(rOtherSimple), dot);
+			EXPECT_EQ(rVectorSimple.minValue(), *std::min_element(native.begin(), native.end()));
+			EXPECT_EQ(rVectorSimple.maxValue(), native[700]);
+			EXPECT_EQ(rVectorSimple.argMin(), static_cast<size_t>(std::min_element(native.begin(), native.end()) - native.begin()));
+			EXPECT_EQ(rVectorSimple.argMax(), 700);
+			rOtherSimple.pop_back();
+			EXPECT_THROW(rVectorSimple.dot(rOtherSimple), std::invalid_argument);
+		}
+		{
+			rVectorSimple = vector<int32_t> { -1, 0, 1, 5, 9, 10, 3 };
+			vector<abi_size_t> counts;
+			rVectorSimple.histogram(0.0, 10.0, 2, counts);
+			EXPECT_EQ(counts, (vector<abi_size_t> { 3, 2 }));
+		}
+	}
+	{
+		vector<float> floats(1001);
+		vector<double> doubles(floats.size());
+		for (size_t j=0; j<floats.size(); ++j) {
+			floats[j] = static_cast<float>(j % 17u) - 8.0f;
+			doubles[j] = static_cast<double>(j % 13u) * 0.5;
+		}
+		VectorRef<float, vector<float>&> rFloats(floats);
+		VectorRef<double, vector<double>&> rDoubles(doubles);
+		EXPECT_EQ(rFloats.sum(), std::accumulate(floats.begin(), floats.end(), 0.0));
+		EXPECT_EQ(rFloats.dot(rFloats), std::inner_product(floats.begin(), floats.end(), floats.begin(), 0.0));
+		EXPECT_EQ(rFloats.minValue(), -8.0f);
+		EXPECT_EQ(rFloats.argMax(), 16);
+		EXPECT_EQ(rDoubles.sum(), std::accumulate(doubles.begin(), doubles.end(), 0.0));
+		EXPECT_EQ(rDoubles.dot(rDoubles), std::inner_product(doubles.begin(), doubles.end(), doubles.begin(), 0.0));
+		EXPECT_EQ(rDoubles.maxValue(), 6.0);
+		EXPECT_EQ(rDoubles.argMin(), 0);
+	}
+	{
+		// NaN values follow the same policy on the scalar and SIMD paths
+		const double nan = std::numeric_limits<double>::quiet_NaN();
+		vector<double> small { 2.0, nan, 1.0, 3.0 };
+		vector<double> large(37, 1.0);
+		large[5] = -1.0;
+		large[20] = nan;
+		large[30] = nan;
+		VectorRef<double, vector<double>&> rSmall(small);
+		VectorRef<double, vector<double>&> rLarge(large);
+		EXPECT_TRUE(std::isnan(rSmall.minValue()));
+		EXPECT_TRUE(std::isnan(rSmall.maxValue()));
+		EXPECT_EQ(rSmall.argMin(), 1);
+		EXPECT_EQ(rSmall.argMax(), 1);
+		EXPECT_TRUE(std::isnan(rLarge.minValue()));
+		EXPECT_TRUE(std::isnan(rLarge.maxValue()));
+		EXPECT_EQ(rLarge.argMin(), 20);
+		EXPECT_EQ(rLarge.argMax(), 20);
+		large[20] = 1.0;
+		large[30] = 1.0;
+		EXPECT_EQ(rLarge.minValue(), -1.0);
+		EXPECT_EQ(rLarge.argMin(), 5);
+		EXPECT_EQ(rLarge.argMax(), 0);
+		vector<float> floats(19, 0.5f);
+		floats[18] = std::numeric_limits<float>::quiet_NaN();
+		VectorRef<float, vector<float>&> rFloats(floats);
+		EXPECT_TRUE(std::isnan(rFloats.maxValue()));
+		EXPECT_EQ(rFloats.argMax(), 18);
+	}
+	{
+		// The index tracking kernels find the first minimum or maximum, with ties in different lanes and in the tail
+		for (size_t n=1; n<80; ++n) {
+			vector<int32_t> ints(n);
+			vector<float> floats(n);
+			vector<double> doubles(n);
+			for (size_t j=0; j<n; ++j) {
+				ints[j] = static_cast<int32_t>((j * 37u) % 11u) - 5;
+				floats[j] = static_cast<float>(ints[j]) * 0.5f;
+				doubles[j] = static_cast<double>(ints[j]) * 0.25;
+			}
+			VectorRef<int32_t, vector<int32_t>&> rInts(ints);
+			VectorRef<float, vector<float>&> rFloats(floats);
+			VectorRef<double, vector<double>&> rDoubles(doubles);
+			EXPECT_EQ(rInts.argMin(), static_cast<size_t>(std::min_element(ints.begin(), ints.end()) - ints.begin()));
+			EXPECT_EQ(rInts.argMax(), static_cast<size_t>(std::max_element(ints.begin(), ints.end()) - ints.begin()));
+			EXPECT_EQ(rFloats.argMin(), static_cast<size_t>(std::min_element(floats.begin(), floats.end()) - floats.begin()));
+			EXPECT_EQ(rFloats.argMax(), static_cast<size_t>(std::max_element(floats.begin(), floats.end()) - floats.begin()));
+			EXPECT_EQ(rDoubles.argMin(), static_cast<size_t>(std::min_element(doubles.begin(), doubles.end()) - doubles.begin()));
+			EXPECT_EQ(rDoubles.argMax(), static_cast<size_t>(std::max_element(doubles.begin(), doubles.end()) - doubles.begin()));
+			floats[n / 2] = std::numeric_limits<float>::quiet_NaN();
+			doubles[n - 1] = std::numeric_limits<double>::quiet_NaN();
+			EXPECT_EQ(rFloats.argMin(), n / 2);
+			EXPECT_EQ(rDoubles.argMax(), n - 1);
+#if lia_SIMD_SSE2
+			for (int isMax=0; isMax<2; ++isMax) {
+				EXPECT_EQ(lia::detail::argMinMaxSse2(ints.data(), n, isMax != 0), lia::detail::argMinMaxScalar(ints.data(), n, isMax != 0));
+				EXPECT_EQ(lia::detail::argMinMaxSse2(floats.data(), n, isMax != 0), lia::detail::argMinMaxScalar(floats.data(), n, isMax != 0));
+				EXPECT_EQ(lia::detail::argMinMaxSse2(doubles.data(), n, isMax != 0), lia::detail::argMinMaxScalar(doubles.data(), n, isMax != 0));
+			}
+#endif
+		}
+	}
+	{
+		// Types without a fixed layout of their results are reduced on the side of the caller
+		vector<long double> values { 1.5L, -2.0L, 4.0L };
+		VectorRef<long double, vector<long double>&> rValues(values);
+		const IVector<long double>& rAbi = rValues;
+		long double result = 0;
+		EXPECT_FALSE(rAbi.abiReduce(kReduceSum, 0, 3, nullptr, &result));
+		EXPECT_EQ(rValues.sum(), 3.5L);
+		EXPECT_EQ(rValues.minValue(), -2.0L);
+		vector<long> longs { 3, 1, 2 };
+		VectorRef<long, vector<long>&> rLongs(longs);
+		const IVector<long>& rLongsAbi = rLongs;
+		abi_size_t index = 0;
+		EXPECT_FALSE(rLongsAbi.abiReduce(kReduceArgMin, 0, 3, nullptr, &index));
+		EXPECT_EQ(rLongs.argMin(), 1);
+	}
+}
+
+TEST(IVector, eraseIfAndUnique) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		{
+			rVectorSimple = vector<int32_t> { 1, 2, 3, 4, 5, 6, 7 };
+			EXPECT_EQ(rVectorSimple.eraseIf([](int32_t x) { return (x % 3) != 0; }), 5);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 3, 6 }));
+			rVectorSimple = vector<int32_t> { 1, 1, 2, 2, 2, 3, 1 };
+			EXPECT_EQ(rVectorSimple.unique(), 3);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 1, 2, 3, 1 }));
+			EXPECT_EQ(rVectorSimple.unique([](int32_t a, int32_t b) { return (a % 2) == (b % 2); }), 1);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 1, 2, 3 }));
+		}
+		{
+			rVectorSimple = vector<int32_t> { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+			const uint8_t byteMask[] = { 1, 0, 0, 1, 0, 0, 0, 0, 0, 1 };
+			EXPECT_EQ(rVectorSimple.keepMasked(byteMask, sizeof(byteMask)), 7);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 0, 3, 9 }));
+			rVectorSimple = vector<int32_t> { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+			const uint8_t bitMask[] = { 0x81, 0x02 };
+			EXPECT_EQ(rVectorSimple.keepMasked(bitMask, sizeof(bitMask), kMaskBits), 7);
+			EXPECT_EQ(static_cast<vector<int32_t>>(rVectorSimple), (vector<int32_t> { 0, 7, 9 }));
+			EXPECT_THROW(rVectorSimple.keepMasked(bitMask, 0u, kMaskBits), std::invalid_argument);
+		}
+		{
+			rVectorComplex = vector<vector<int32_t>> { { 1 }, { 1, 2 }, { 1, 2 }, { }, { 3 } };
+			EXPECT_EQ(rVectorComplex.unique(), 1);
+			EXPECT_EQ(rVectorComplex.eraseIf([](const auto& inner) { return inner.empty(); }), 1);
+			EXPECT_EQ(static_cast<vector<vector<int32_t>>>(rVectorComplex), (vector<vector<int32_t>> { { 1 }, { 1, 2 }, { 3 } }));
+			EXPECT_EQ(rVectorComplex.unique([](const auto& a, const auto& b) { return a[0] == b[0]; }), 1);
+			EXPECT_THROW(rVectorComplex.keepMasked(vector<uint8_t> { 1 }), std::invalid_argument);
+			EXPECT_EQ(rVectorComplex.keepMasked(vector<uint8_t> { 0, 1 }), 1);
+			EXPECT_EQ(static_cast<vector<vector<int32_t>>>(rVectorComplex), (vector<vector<int32_t>> { { 3 } }));
+			EXPECT_THROW(rVectorComplex.eraseIf([](const auto&) -> bool { throw std::runtime_error("in predicate"); }), std::runtime_error);
+		}
+	}
+}
+
+TEST(IVector, gatherAndScatter) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		{
+			vector<int32_t> values(100);
+			vector<abi_size_t> indices;
+			for (size_t j=0; j<values.size(); ++j) {
+				values[j] = static_cast<int32_t>(j * 10u);
+				indices.push_back(static_cast<abi_size_t>((j * 37u) % values.size()));
+			}
+			rVectorSimple = values;
+			vector<int32_t> gathered;
+			rVectorSimple.gather(indices, gathered);
+			ASSERT_EQ(gathered.size(), indices.size());
+			for (size_t j=0; j<indices.size(); ++j) {
+				EXPECT_EQ(gathered[j], values[indices[j]]);
+			}
+			rVectorSimple.scatter(indices, vector<int32_t>(indices.size(), -1));
+			EXPECT_EQ(rVectorSimple.count(-1), values.size());
+			const vector<abi_size_t> invalid { 1u, 100u };
+			EXPECT_THROW(rVectorSimple.scatter(invalid, vector<int32_t> { 5, 6 }), std::out_of_range);
+			EXPECT_EQ(rVectorSimple[1], -1);
+			EXPECT_THROW(rVectorSimple.gather(invalid, gathered), std::out_of_range);
+		}
+		{
+			rVectorComplex = vector<vector<int32_t>> { { 1 }, { 2, 3 }, { } };
+			const vector<abi_size_t> indices { 2u, 1u, 1u };
+			vector<vector<int32_t>> gathered;
+			rVectorComplex.gather(indices, gathered);
+			EXPECT_EQ(gathered, (vector<vector<int32_t>> { { }, { 2, 3 }, { 2, 3 } }));
+			rVectorComplex.scatter(indices, vector<vector<int32_t>> { { 4 }, { 5 }, { 6, 7 } });
+			EXPECT_EQ(static_cast<vector<vector<int32_t>>>(rVectorComplex), (vector<vector<int32_t>> { { 1 }, { 6, 7 }, { 4 } }));
+		}
+	}
+}
+
+namespace {
+
+struct AddSizes {
+	size_t operator()(size_t a, size_t b) const {
+		return a + b;
+	}
+
+	template<typename U>
+	size_t operator()(size_t a, const U& u) const {
+		return a + u.size();
+	}
+};
+
+}
+
+TEST(IVector, parallel) {
+	const auto vecs = makeVectors();
+	EXPECT_GT(vecs.size(), 0);
+	for (size_t i=0; i<vecs.size(); ++i) {
+		unique_ptr<IVector<int32_t>> pVectorSimple((*vecs[i].first)());
+		unique_ptr<IVector<int32_t>> pVectorOut((*vecs[i].first)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplex((*vecs[i].second)());
+		unique_ptr<IVector<IVector<int32_t>>> pVectorComplexOut((*vecs[i].second)());
+		auto& rVectorSimple  = *pVectorSimple;
+		auto& rVectorComplex = *pVectorComplex;
+		const parallel::Policy policy(4u, 1000u);
+		{
+			vector<int32_t> values(10007);
+			std::iota(values.begin(), values.end(), 0);
+			rVectorSimple = values;
+			parallel::for_each(rVectorSimple, [](int32_t& x) { x *= 2; }, policy);
+			EXPECT_EQ(parallel::reduce(rVectorSimple, int64_t(0), std::plus<int64_t>(), policy), int64_t(10006) * 10007);
+			parallel::transform(rVectorSimple, *pVectorOut, [](int32_t x) { return x + 1; }, policy);
+			ASSERT_EQ(pVectorOut->size(), values.size());
+			EXPECT_EQ((*pVectorOut)[10006], 20013);
+			parallel::copy(rVectorSimple, *pVectorOut, policy);
+			EXPECT_EQ(*pVectorOut, rVectorSimple);
+			std::atomic<int64_t> sum(0);
+			parallel::for_each(static_cast<const IVector<int32_t>&>(rVectorSimple), [&sum](int32_t x) { sum += x; }, policy);
+			EXPECT_EQ(sum.load(), int64_t(10006) * 10007);
+		}
+		{
+			rVectorSimple = vector<int32_t>(5000, 1);
+			rVectorSimple[17] = 1 << 30;
+			EXPECT_THROW(parallel::for_each(rVectorSimple, [](int32_t x) { if (x > 1) { throw std::runtime_error("in function"); } }, policy), std::runtime_error);
+			vector<int32_t> flags(5000, 0);
+			flags[4321] = 1;
+			rVectorSimple = flags;
+			const auto logicalOr = [](bool a, bool b) { return a || b; };
+			EXPECT_TRUE(parallel::reduce(rVectorSimple, false, logicalOr, parallel::Policy(8u, 10u, true)));
+			EXPECT_TRUE(parallel::reduce(rVectorSimple, false, logicalOr, parallel::Policy(8u, 10u)));
+		}
+		{
+			// Floating point addition isn't associative. The deterministic mode adds the elements of each range in order
+			// and then the results of the ranges in index order, for any number of threads.
+			vector<double> values(5003);
+			for (size_t j=0; j<values.size(); ++j) {
+				values[j] = ((j % 3u == 0u) ? 1e16 : 1.0) * ((j % 2u == 0u) ? 1.0 : -1.0) + static_cast<double>(j) * 0.1;
+			}
+			VectorRef<double, vector<double>&> rValues(values);
+			double serial = 0.0;
+			for (size_t first=0; first<values.size(); first+=100u) {
+				double rangeSum = 0.0;
+				for (size_t j=first; j<std::min(first + 100u, values.size()); ++j) {
+					rangeSum += values[j];
+				}
+				serial += rangeSum;
+			}
+			EXPECT_NE(std::accumulate(values.begin(), values.end(), 0.0), serial); // the sum depends on the order
+			for (size_t numThreads : { 1u, 2u, 3u, 8u }) {
+				EXPECT_EQ(parallel::reduce(rValues, 0.0, std::plus<double>(), parallel::Policy(numThreads, 100u, true)), serial);
+			}
+		}
+		{
+			rVectorComplex = vector<vector<int32_t>> { { 1 }, { 2, 3 }, { }, { 4, 5, 6 } };
+			EXPECT_EQ(parallel::reduce(rVectorComplex, size_t(0), AddSizes(), parallel::Policy(2u, 1u)), 6);
+			parallel::for_each(rVectorComplex, [](auto&& inner) { inner.push_back(0); }, parallel::Policy(2u, 1u));
+			parallel::copy(rVectorComplex, *pVectorComplexOut, parallel::Policy(2u, 1u));
+			EXPECT_EQ(static_cast<vector<vector<int32_t>>>(*pVectorComplexOut), (vector<vector<int32_t>> { { 1, 0 }, { 2, 3, 0 }, { 0 }, { 4, 5, 6, 0 } }));
+		}
+	}
+}